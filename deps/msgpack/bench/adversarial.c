@@ -0,0 +1,110 @@
+/* Feeds crafted messages whose headers claim far more than they carry and
+ * reports what parsing them costs, with the default limits and with a
+ * limit on the decoded size.
+ *
+ *   gcc -O2 -I.. adversarial.c ../unpack.c ../objectc.c ../zone.c -o adversarial
+ *   ./adversarial
+ */
+
+#include <msgpack.h>
+#include <malloc.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+
+#define LOOP 200
+#define INPUT_SIZE 65536
+
+static double now(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static size_t allocated(void)
+{
+	struct mallinfo2 mi = mallinfo2();
+	return mi.uordblks + mi.hblkhd;
+}
+
+static const char* result_name(msgpack_unpack_return ret)
+{
+	switch(ret) {
+	case MSGPACK_UNPACK_SUCCESS:    return "success";
+	case MSGPACK_UNPACK_EXTRA_BYTES: return "extra bytes";
+	case MSGPACK_UNPACK_CONTINUE:   return "continue";
+	case MSGPACK_UNPACK_PARSE_ERROR: return "parse error";
+	default:                        return "?";
+	}
+}
+
+static void bench(const char* name, const char* data, size_t len,
+		const msgpack_unpack_limit* limit)
+{
+	msgpack_zone z;
+	msgpack_object obj;
+	msgpack_unpack_return ret = MSGPACK_UNPACK_SUCCESS;
+	size_t base, peak = 0;
+	double t;
+	unsigned int i;
+
+	t = now();
+	for(i = 0; i < LOOP; ++i) {
+		msgpack_zone_init(&z, MSGPACK_ZONE_CHUNK_SIZE);
+		base = allocated();
+		ret = msgpack_unpack_limited(data, len, NULL, &z, &obj, limit);
+		if(allocated() - base > peak) { peak = allocated() - base; }
+		msgpack_zone_destroy(&z);
+	}
+	t = now() - t;
+
+	printf("%-22s %-8s %6lu bytes in  %8lu bytes allocated  %8.2f us  %s\n",
+			name, limit ? "limited" : "default",
+			(unsigned long)len, (unsigned long)peak,
+			t / LOOP * 1e6, result_name(ret));
+}
+
+static void run(const char* name, const char* data, size_t len)
+{
+	msgpack_unpack_limit limit;
+	msgpack_unpack_limit_init(&limit);
+	limit.total = 1024 * 1024;
+
+	bench(name, data, len, NULL);
+	bench(name, data, len, &limit);
+}
+
+int main(void)
+{
+	static char buf[INPUT_SIZE];
+	size_t i;
+
+	/* a single element of an array claiming 4G of them */
+	memcpy(buf, "\xdd\xff\xff\xff\xff\x01", 6);
+	run("huge array", buf, 6);
+
+	memcpy(buf, "\xdf\xff\xff\xff\xff\x01\x01", 7);
+	run("huge map", buf, 7);
+
+	memcpy(buf, "\xdb\xff\xff\xff\xff\x01", 6);
+	run("huge raw", buf, 6);
+
+	/* every level claims 4G elements */
+	for(i = 0; i < 32; ++i) {
+		memcpy(buf + i*5, "\xdd\xff\xff\xff\xff", 5);
+	}
+	run("nested huge arrays", buf, 32*5);
+
+	/* every level claims 64K pairs */
+	for(i = 0; i < 32; ++i) {
+		memcpy(buf + i*3, "\xde\xff\xff", 3);
+	}
+	run("nested huge maps", buf, 32*3);
+
+	/* nesting past the maximum depth */
+	memset(buf, 0x91, INPUT_SIZE);
+	run("deep nesting", buf, INPUT_SIZE);
+
+	return 0;
+}
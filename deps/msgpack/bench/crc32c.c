@@ -0,0 +1,52 @@
+/* Measures CRC32C throughput with the crc32 instruction, when the CPU has
+ * it, and with the slicing-by-8 tables.
+ *
+ *   gcc -O2 -I.. crc32c.c ../crc32c.c -o crc32c
+ *   ./crc32c
+ */
+
+#include <msgpack/crc32c.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIZE (1024 * 1024)
+#define LOOP 256
+
+static double now(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void bench(const char* name,
+		uint32_t (*crc)(uint32_t, const void*, size_t), const char* buf)
+{
+	uint32_t c = 0;
+	unsigned int i;
+	double t = now();
+	for(i = 0; i < LOOP; ++i) {
+		c = (*crc)(c, buf, SIZE);
+	}
+	t = now() - t;
+
+	printf("%-8s %6.2f GB/s  %.3f ns/byte  (%08x)\n", name,
+			(double)SIZE * LOOP / t / 1e9, t * 1e9 / ((double)SIZE * LOOP), c);
+}
+
+int main(void)
+{
+	char* buf = (char*)malloc(SIZE);
+	unsigned int i;
+	for(i = 0; i < SIZE; ++i) {
+		buf[i] = (char)rand();
+	}
+
+	printf("crc32 instruction: %s\n", msgpack_crc32c_hw() ? "yes" : "no");
+	bench("auto", msgpack_crc32c, buf);
+	bench("tables", msgpack_crc32c_sw, buf);
+
+	free(buf);
+	return 0;
+}
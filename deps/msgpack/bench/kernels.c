@@ -0,0 +1,116 @@
+/* Measures the header decode and integer encode kernels on int-heavy and
+ * small-map payloads. Build it once as is and once with the original
+ * switch / if-chain code to compare:
+ *
+ *   gcc -O2 -I.. kernels.c ../unpack.c ../objectc.c ../zone.c -o kernels
+ *   gcc -O2 -I.. -DMSGPACK_UNPACK_NO_HEADER_TABLE -DMSGPACK_PACK_NO_CLZ \
+ *       kernels.c ../unpack.c ../objectc.c ../zone.c -o kernels_switch
+ *   ./kernels && ./kernels_switch
+ */
+
+#include <msgpack.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ROUNDS 30
+#define LOOP 20
+#define INTS 100000
+#define MAPS 20000
+
+static double now(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/* every encoding of an integer, in no particular order */
+static int64_t mixed_int(unsigned int i)
+{
+	static const int shifts[] = { 0, 6, 9, 13, 17, 24, 31, 40, 50, 62 };
+	uint64_t r = (uint64_t)i * 2654435761U;
+	int64_t v = (int64_t)(r >> (63 - shifts[i % 10]));
+	return (i & 1) ? -v : v;
+}
+
+static void pack_ints(msgpack_packer* pk)
+{
+	unsigned int i;
+	msgpack_pack_array(pk, INTS);
+	for(i = 0; i < INTS; ++i) {
+		msgpack_pack_int64(pk, mixed_int(i));
+	}
+}
+
+static void pack_maps(msgpack_packer* pk)
+{
+	unsigned int i;
+	msgpack_pack_array(pk, MAPS);
+	for(i = 0; i < MAPS; ++i) {
+		msgpack_pack_map(pk, 4);
+		msgpack_pack_raw(pk, 2);
+		msgpack_pack_raw_body(pk, "id", 2);
+		msgpack_pack_uint32(pk, i);
+		msgpack_pack_raw(pk, 1);
+		msgpack_pack_raw_body(pk, "x", 1);
+		msgpack_pack_int32(pk, (int)(i % 300) - 150);
+		msgpack_pack_raw(pk, 1);
+		msgpack_pack_raw_body(pk, "y", 1);
+		msgpack_pack_int32(pk, (int)(i % 70000) - 35000);
+		msgpack_pack_raw(pk, 2);
+		msgpack_pack_raw_body(pk, "ok", 2);
+		if(i % 2) { msgpack_pack_true(pk); } else { msgpack_pack_false(pk); }
+	}
+}
+
+static void bench(const char* name, void (*fill)(msgpack_packer*))
+{
+	msgpack_sbuffer sbuf;
+	msgpack_packer pk;
+	msgpack_zone z;
+	msgpack_object obj;
+	double t, pack, unpack;
+	unsigned int i, r;
+
+	msgpack_sbuffer_init(&sbuf);
+	msgpack_packer_init(&pk, &sbuf, msgpack_sbuffer_write);
+
+	/* best of ROUNDS to filter out noise */
+	pack = unpack = 1e9;
+	msgpack_zone_init(&z, 8192);
+	for(r = 0; r < ROUNDS; ++r) {
+		t = now();
+		for(i = 0; i < LOOP; ++i) {
+			sbuf.size = 0;
+			(*fill)(&pk);
+		}
+		t = now() - t;
+		if(t < pack) { pack = t; }
+
+		t = now();
+		for(i = 0; i < LOOP; ++i) {
+			size_t off = 0;
+			if(msgpack_unpack(sbuf.data, sbuf.size, &off, &z, &obj) != MSGPACK_UNPACK_SUCCESS) {
+				fprintf(stderr, "unpack failed\n");
+				exit(1);
+			}
+			msgpack_zone_clear(&z);
+		}
+		t = now() - t;
+		if(t < unpack) { unpack = t; }
+	}
+
+	printf("%-10s %7lu bytes  pack: %.2f ms  unpack: %.2f ms\n",
+			name, (unsigned long)sbuf.size, pack * 1e3, unpack * 1e3);
+
+	msgpack_zone_destroy(&z);
+	msgpack_sbuffer_destroy(&sbuf);
+}
+
+int main(void)
+{
+	bench("ints", pack_ints);
+	bench("small maps", pack_maps);
+	return 0;
+}
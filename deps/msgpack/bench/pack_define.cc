@@ -0,0 +1,94 @@
+// Compares packing MSGPACK_DEFINE structs through the fixed-size fast path
+// with the token-by-token packer on a few kinds of streams.
+//
+//   g++ -O2 -I.. pack_define.cc ../.libs/libmsgpack.a -o pack_define
+//   ./pack_define
+
+#include <msgpack.hpp>
+#include <sys/time.h>
+#include <stdio.h>
+#include <sstream>
+
+static const unsigned int LOOP = 2000;
+static const unsigned int BATCH = 1000;
+
+struct point {
+	point() : id(0), x(0), y(0), z(0), flags(0), visible(false) { }
+
+	unsigned int id;
+	double x;
+	double y;
+	double z;
+	int flags;
+	bool visible;
+
+	MSGPACK_DEFINE(id, x, y, z, flags, visible);
+};
+
+static double now()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+// Each message is packed out of line, as it is when a program packs a
+// message from its handler.
+template <typename Stream>
+__attribute__((noinline))
+static void pack_token(msgpack::packer<Stream>& pk, const point& p)
+{
+	msgpack::type::make_define(p.id, p.x, p.y, p.z, p.flags, p.visible).msgpack_pack(pk);
+}
+
+template <typename Stream>
+__attribute__((noinline))
+static void pack_fixed(msgpack::packer<Stream>& pk, const point& p)
+{
+	pk.pack(p);
+}
+
+template <typename Stream>
+static void bench(const char* name, const point* points)
+{
+	double t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		Stream s;
+		msgpack::packer<Stream> pk(s);
+		for(unsigned int j = 0; j < BATCH; ++j) {
+			pack_token(pk, points[j]);
+		}
+	}
+	double token = now() - t;
+
+	t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		Stream s;
+		msgpack::packer<Stream> pk(s);
+		for(unsigned int j = 0; j < BATCH; ++j) {
+			pack_fixed(pk, points[j]);
+		}
+	}
+	double fixed = now() - t;
+
+	printf("%-10s per-token: %.3f sec  fixed-size: %.3f sec\n", name, token, fixed);
+}
+
+int main(void)
+{
+	static point points[BATCH];
+	for(unsigned int i = 0; i < BATCH; ++i) {
+		points[i].id = i * 7919;
+		points[i].x = i * 0.25;
+		points[i].y = -3.5 * i;
+		points[i].z = 1e10 / (i + 1);
+		points[i].flags = (int)(i % 64) - 32;
+		points[i].visible = i % 2;
+	}
+
+	bench<msgpack::sbuffer>("sbuffer", points);
+	bench<msgpack::vrefbuffer>("vrefbuffer", points);
+	bench<std::ostringstream>("ostream", points);
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+// Measures the cost of handing decoded messages over through an
+// unpacked_queue: first the queue operations alone on one thread, then
+// an I/O thread parsing into a zone_pool and a worker consuming, with
+// batches of 1 and 32 messages.
+//
+//   g++ -O2 -I.. unpacked_queue.cc ../.libs/libmsgpack.a -lpthread -o unpacked_queue
+//   ./unpacked_queue
+
+#include <msgpack.hpp>
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+static const unsigned int MESSAGES = 1000000;
+
+static double now()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void feed(msgpack::unpacker& pac, const msgpack::sbuffer& sbuf)
+{
+	pac.reserve_buffer(sbuf.size());
+	memcpy(pac.buffer(), sbuf.data(), sbuf.size());
+	pac.buffer_consumed(sbuf.size());
+}
+
+static void bench_ops(size_t batch)
+{
+	msgpack::zone_pool pool;
+	msgpack::unpacked_queue queue(1024);
+	msgpack::pooled_unpacked in[32];
+	msgpack::queued_unpacked out[32];
+
+	double t = now();
+	for(unsigned int i = 0; i < MESSAGES; i += batch) {
+		for(size_t j = 0; j < batch; ++j) {
+			in[j].get() = msgpack::object(i + j);
+		}
+		queue.push(in, batch);
+		queue.pop(out, batch);
+	}
+	double ops = now() - t;
+
+	printf("push+pop  batch %2lu: %.1f ns/message\n",
+			(unsigned long)batch, ops / MESSAGES * 1e9);
+}
+
+
+struct consumer_arg {
+	msgpack::unpacked_queue* queue;
+	size_t batch;
+	unsigned long count;
+	unsigned long sum;
+};
+
+static void* consumer(void* p)
+{
+	consumer_arg* arg = (consumer_arg*)p;
+	msgpack::queued_unpacked out[32];
+	while(arg->count < MESSAGES) {
+		size_t n = arg->queue->pop(out, arg->batch);
+		if(n == 0) {
+			sched_yield();
+			continue;
+		}
+		for(size_t i = 0; i < n; ++i) {
+			arg->sum += out[i].get().via.u64;
+			out[i].reset();
+		}
+		arg->count += n;
+	}
+	return NULL;
+}
+
+static void bench_threads(const msgpack::sbuffer& sbuf, size_t batch)
+{
+	msgpack::unpacker pac;
+	feed(pac, sbuf);
+
+	msgpack::zone_pool pool(1024);
+	msgpack::unpacked_queue queue(1024);
+	consumer_arg arg = { &queue, batch, 0, 0 };
+
+	msgpack::pooled_unpacked msgs[32];
+	for(size_t i = 0; i < batch; ++i) {
+		msgs[i].set_pool(&pool);
+	}
+
+	double t = now();
+	pthread_t th;
+	pthread_create(&th, NULL, consumer, &arg);
+
+	bool more = true;
+	while(more) {
+		size_t n = 0;
+		while(n < batch && (more = pac.next(&msgs[n]))) {
+			++n;
+		}
+		size_t done = 0;
+		while(done < n) {
+			done += queue.push(&msgs[done], n - done);
+			if(done < n) {
+				queue.reclaim(&pool);
+				sched_yield();
+			}
+		}
+		queue.reclaim(&pool);
+	}
+
+	pthread_join(th, NULL);
+	double total = now() - t;
+
+	printf("threads   batch %2lu: %.1f ns/message (parse + handoff)  (%lu)\n",
+			(unsigned long)batch, total / MESSAGES * 1e9, arg.sum);
+}
+
+static void bench_parse(const msgpack::sbuffer& sbuf)
+{
+	msgpack::unpacker pac;
+	feed(pac, sbuf);
+
+	msgpack::zone_pool pool(1024);
+	msgpack::pooled_unpacked msg(&pool);
+	unsigned long sum = 0;
+
+	double t = now();
+	while(pac.next(&msg)) {
+		sum += msg.get().via.u64;
+	}
+	double total = now() - t;
+
+	printf("no handoff        : %.1f ns/message (parse only)  (%lu)\n",
+			total / MESSAGES * 1e9, sum);
+}
+
+int main(void)
+{
+	bench_ops(1);
+	bench_ops(32);
+
+	msgpack::sbuffer sbuf;
+	for(unsigned int i = 0; i < MESSAGES; ++i) {
+		msgpack::pack(sbuf, i);
+	}
+
+	bench_parse(sbuf);
+	bench_threads(sbuf, 1);
+	bench_threads(sbuf, 32);
+
+	return 0;
+}
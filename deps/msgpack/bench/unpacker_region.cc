@@ -0,0 +1,66 @@
+// Compares copying reads into the unpacker's buffer with parsing them in
+// place through feed_region() on raw-heavy messages.
+//
+//   g++ -O2 -I.. unpacker_region.cc ../.libs/libmsgpack.a -o unpacker_region
+//   ./unpacker_region
+
+#include <msgpack.hpp>
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+
+static const unsigned int LOOP = 200;
+static const unsigned int MESSAGES = 2000;
+static const size_t READ_SIZE = 64 * 1024;
+
+static double now()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+int main(void)
+{
+	msgpack::sbuffer sbuf;
+	for(unsigned int i = 0; i < MESSAGES; ++i) {
+		msgpack::type::tuple<unsigned int, std::string> msg(i, std::string(1000 + i % 512, 'x'));
+		msgpack::pack(sbuf, msg);
+	}
+
+	unsigned long n = 0;
+
+	double t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		msgpack::unpacker pac;
+		msgpack::unpacked result;
+		for(size_t off = 0; off < sbuf.size(); off += READ_SIZE) {
+			size_t len = std::min(READ_SIZE, sbuf.size() - off);
+			pac.reserve_buffer(len);
+			memcpy(pac.buffer(), sbuf.data() + off, len);
+			pac.buffer_consumed(len);
+			while(pac.next(&result)) {
+				n += result.get().via.array.ptr[1].via.raw.size;
+			}
+		}
+	}
+	double copy = now() - t;
+
+	t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		msgpack::unpacker pac;
+		msgpack::unpacked result;
+		for(size_t off = 0; off < sbuf.size(); off += READ_SIZE) {
+			size_t len = std::min(READ_SIZE, sbuf.size() - off);
+			pac.feed_region(sbuf.data() + off, len);
+			while(pac.next(&result)) {
+				n += result.get().via.array.ptr[1].via.raw.size;
+			}
+		}
+	}
+	double region = now() - t;
+
+	printf("copied: %.3f sec  in place: %.3f sec  (%lu)\n", copy, region, n);
+
+	return 0;
+}
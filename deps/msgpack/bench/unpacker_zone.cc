@@ -0,0 +1,80 @@
+// Compares the zone handling of unpacker::next() when a fresh zone is
+// allocated for every message, when the zone held by the result is
+// reused, and when messages are handed off and their zones come back
+// through a zone_pool.
+//
+//   g++ -O2 -I.. unpacker_zone.cc ../.libs/libmsgpack.a -o unpacker_zone
+//   ./unpacker_zone
+
+#include <msgpack.hpp>
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+
+static const unsigned int LOOP = 200;
+static const unsigned int MESSAGES = 10000;
+
+static double now()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void feed(msgpack::unpacker& pac, const msgpack::sbuffer& sbuf)
+{
+	pac.reserve_buffer(sbuf.size());
+	memcpy(pac.buffer(), sbuf.data(), sbuf.size());
+	pac.buffer_consumed(sbuf.size());
+}
+
+int main(void)
+{
+	msgpack::sbuffer sbuf;
+	for(unsigned int i = 0; i < MESSAGES; ++i) {
+		std::vector<int> v(8, i);
+		msgpack::pack(sbuf, v);
+	}
+
+	msgpack::unpacker pac;
+	unsigned long n = 0;
+
+	double t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		feed(pac, sbuf);
+		msgpack::unpacked result;
+		while(pac.next(&result)) {
+			n += result.get().via.array.size;
+			result.zone().reset();  // the message is handed off
+		}
+	}
+	double fresh = now() - t;
+
+	t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		feed(pac, sbuf);
+		msgpack::unpacked result;
+		while(pac.next(&result)) {
+			n += result.get().via.array.size;
+		}
+	}
+	double reuse = now() - t;
+
+	msgpack::zone_pool pool;
+	t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		feed(pac, sbuf);
+		msgpack::pooled_unpacked result(&pool);
+		while(pac.next(&result)) {
+			msgpack::pooled_unpacked handed(&pool);
+			handed.swap(result);
+			n += handed.get().via.array.size;
+		}
+	}
+	double pooled = now() - t;
+
+	printf("new zone: %.3f sec  reused zone: %.3f sec  zone_pool: %.3f sec  (%lu)\n",
+			fresh, reuse, pooled, n);
+
+	return 0;
+}
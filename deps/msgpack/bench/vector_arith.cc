@@ -0,0 +1,120 @@
+// Compares packing std::vector of arithmetic types through the batched
+// path of type/vector.hpp with an element-by-element loop, and decoding
+// them with unpack_array() with unpack() followed by convert().
+//
+//   g++ -O2 -I.. vector_arith.cc ../.libs/libmsgpack.a -o vector_arith
+//   ./vector_arith
+
+#include <msgpack.hpp>
+#include <sys/time.h>
+#include <stdio.h>
+#include <sstream>
+
+static const unsigned int LOOP = 200;
+static const unsigned int SIZE = 100000;
+
+static double now()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+template <typename Stream, typename T>
+__attribute__((noinline))
+static void pack_each(msgpack::packer<Stream>& pk, const std::vector<T>& v)
+{
+	pk.pack_array(v.size());
+	for(size_t i = 0; i < v.size(); ++i) {
+		pk.pack(v[i]);
+	}
+}
+
+template <typename Stream, typename T>
+__attribute__((noinline))
+static void pack_bulk(msgpack::packer<Stream>& pk, const std::vector<T>& v)
+{
+	pk.pack(v);
+}
+
+template <typename T>
+__attribute__((noinline))
+static void decode_object(const msgpack::sbuffer& sbuf, std::vector<T>& v)
+{
+	msgpack::unpacked msg;
+	msgpack::unpack(&msg, sbuf.data(), sbuf.size());
+	msg.get().convert(&v);
+}
+
+template <typename T>
+__attribute__((noinline))
+static void decode_array(const msgpack::sbuffer& sbuf, std::vector<T>& v)
+{
+	msgpack::unpack_array(&v, sbuf.data(), sbuf.size());
+}
+
+template <typename Stream, typename T>
+static void bench_pack(const char* name, const std::vector<T>& v)
+{
+	double t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		Stream s;
+		msgpack::packer<Stream> pk(s);
+		pack_each(pk, v);
+	}
+	double each = now() - t;
+
+	t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		Stream s;
+		msgpack::packer<Stream> pk(s);
+		pack_bulk(pk, v);
+	}
+	double bulk = now() - t;
+
+	printf("pack    %-22s per-element: %.3f sec  bulk: %.3f sec\n", name, each, bulk);
+}
+
+template <typename T>
+static void bench_unpack(const char* name, const std::vector<T>& v)
+{
+	msgpack::sbuffer sbuf;
+	msgpack::pack(sbuf, v);
+	std::vector<T> to;
+
+	double t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		decode_object(sbuf, to);
+	}
+	double object = now() - t;
+
+	t = now();
+	for(unsigned int i = 0; i < LOOP; ++i) {
+		decode_array(sbuf, to);
+	}
+	double array = now() - t;
+
+	printf("unpack  %-22s via object: %.3f sec  unpack_array: %.3f sec\n", name, object, array);
+}
+
+int main(void)
+{
+	std::vector<int> iv(SIZE);
+	std::vector<double> dv(SIZE);
+	for(unsigned int i = 0; i < SIZE; ++i) {
+		iv[i] = (int)(i * 2654435761U) >> (i % 24);
+		dv[i] = i * 0.25 - 1000.0;
+	}
+
+	bench_pack<msgpack::sbuffer>("int sbuffer", iv);
+	bench_pack<msgpack::sbuffer>("double sbuffer", dv);
+	bench_pack<msgpack::vrefbuffer>("int vrefbuffer", iv);
+	bench_pack<msgpack::vrefbuffer>("double vrefbuffer", dv);
+	bench_pack<std::ostringstream>("int ostream", iv);
+	bench_pack<std::ostringstream>("double ostream", dv);
+
+	bench_unpack("int", iv);
+	bench_unpack("double", dv);
+
+	return 0;
+}
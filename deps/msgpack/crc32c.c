@@ -0,0 +1,160 @@
+/*
+ * MessagePack for C CRC32C (Castagnoli) checksum
+ *
+ * Copyright (C) 2008-2010 FURUHASHI Sadayuki
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include "msgpack/crc32c.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+	((__GNUC__ * 100 + __GNUC_MINOR__) >= 409 || defined(__clang__))
+#define MSGPACK_CRC32C_SSE42
+#include <cpuid.h>
+#endif
+
+/* reflected Castagnoli polynomial */
+#define CRC32C_POLY 0x82f63b78
+
+/* table[k][b] is the CRC of byte b followed by k zero bytes */
+static uint32_t crc32c_table[8][256];
+static volatile int crc32c_table_ready = 0;
+
+static void crc32c_init_table(void)
+{
+	unsigned int b, k;
+	for(b = 0; b < 256; ++b) {
+		uint32_t c = b;
+		for(k = 0; k < 8; ++k) {
+			c = (c & 1) ? (c >> 1) ^ CRC32C_POLY : c >> 1;
+		}
+		crc32c_table[0][b] = c;
+	}
+	for(b = 0; b < 256; ++b) {
+		for(k = 1; k < 8; ++k) {
+			uint32_t c = crc32c_table[k-1][b];
+			crc32c_table[k][b] = (c >> 8) ^ crc32c_table[0][c & 0xff];
+		}
+	}
+	/* threads racing here compute the same tables */
+	_msgpack_store_release(&crc32c_table_ready, 1);
+}
+
+uint32_t msgpack_crc32c_sw(uint32_t crc, const void* buf, size_t len)
+{
+	const unsigned char* p = (const unsigned char*)buf;
+	uint32_t c = ~crc;
+
+	if(!_msgpack_load_acquire(&crc32c_table_ready)) {
+		crc32c_init_table();
+	}
+
+	for(; len > 0 && ((size_t)p & 7) != 0; ++p, --len) {
+		c = (c >> 8) ^ crc32c_table[0][(c ^ *p) & 0xff];
+	}
+
+	for(; len >= 8; p += 8, len -= 8) {
+		uint32_t lo = c ^ ((uint32_t)p[0] | (uint32_t)p[1] << 8 |
+				(uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+		c = crc32c_table[7][lo & 0xff] ^
+			crc32c_table[6][(lo >> 8) & 0xff] ^
+			crc32c_table[5][(lo >> 16) & 0xff] ^
+			crc32c_table[4][lo >> 24] ^
+			crc32c_table[3][p[4]] ^
+			crc32c_table[2][p[5]] ^
+			crc32c_table[1][p[6]] ^
+			crc32c_table[0][p[7]];
+	}
+
+	for(; len > 0; ++p, --len) {
+		c = (c >> 8) ^ crc32c_table[0][(c ^ *p) & 0xff];
+	}
+
+	return ~c;
+}
+
+#ifdef MSGPACK_CRC32C_SSE42
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const void* buf, size_t len)
+{
+	const unsigned char* p = (const unsigned char*)buf;
+	uint32_t c = ~crc;
+
+	for(; len > 0 && ((size_t)p & 7) != 0; ++p, --len) {
+		c = __builtin_ia32_crc32qi(c, *p);
+	}
+
+#ifdef __x86_64__
+	{
+		uint64_t c64 = c;
+		for(; len >= 8; p += 8, len -= 8) {
+			uint64_t w;
+			memcpy(&w, p, 8);
+			c64 = __builtin_ia32_crc32di(c64, w);
+		}
+		c = (uint32_t)c64;
+	}
+#else
+	for(; len >= 4; p += 4, len -= 4) {
+		uint32_t w;
+		memcpy(&w, p, 4);
+		c = __builtin_ia32_crc32si(c, w);
+	}
+#endif
+
+	for(; len > 0; ++p, --len) {
+		c = __builtin_ia32_crc32qi(c, *p);
+	}
+
+	return ~c;
+}
+
+/* 1 if the CPU has SSE4.2, 0 if not, -1 until checked */
+static volatile int crc32c_sse42_available = -1;
+
+bool msgpack_crc32c_hw(void)
+{
+	int avail = _msgpack_load_acquire(&crc32c_sse42_available);
+	if(avail < 0) {
+		unsigned int eax, ebx, ecx, edx;
+		avail = __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+			(ecx & bit_SSE4_2) ? 1 : 0;
+		_msgpack_store_release(&crc32c_sse42_available, avail);
+	}
+	return avail != 0;
+}
+
+uint32_t msgpack_crc32c(uint32_t crc, const void* buf, size_t len)
+{
+	if(msgpack_crc32c_hw()) {
+		return crc32c_sse42(crc, buf, len);
+	}
+	return msgpack_crc32c_sw(crc, buf, len);
+}
+
+#else
+
+bool msgpack_crc32c_hw(void)
+{
+	return false;
+}
+
+uint32_t msgpack_crc32c(uint32_t crc, const void* buf, size_t len)
+{
+	return msgpack_crc32c_sw(crc, buf, len);
+}
+
+#endif
+
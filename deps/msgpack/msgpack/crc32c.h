@@ -0,0 +1,47 @@
+/*
+ * MessagePack for C CRC32C (Castagnoli) checksum
+ *
+ * Copyright (C) 2008-2010 FURUHASHI Sadayuki
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#ifndef MSGPACK_CRC32C_H__
+#define MSGPACK_CRC32C_H__
+
+#include "msgpack/sysdep.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* CRC32C of `len' bytes at `buf', continuing from `crc', which is 0 for
+ * the first piece and the result of the previous call for the next ones.
+ * Uses the SSE4.2 crc32 instruction when the CPU has it, and slicing-by-8
+ * tables otherwise. */
+uint32_t msgpack_crc32c(uint32_t crc, const void* buf, size_t len);
+
+/* the same with the tables, whatever the CPU */
+uint32_t msgpack_crc32c_sw(uint32_t crc, const void* buf, size_t len);
+
+/* whether msgpack_crc32c() uses the crc32 instruction */
+bool msgpack_crc32c_hw(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* msgpack/crc32c.h */
+
@@ -35,6 +35,9 @@ typedef enum {
 	MSGPACK_OBJECT_RAW					= 0x05,
 	MSGPACK_OBJECT_ARRAY				= 0x06,
 	MSGPACK_OBJECT_MAP					= 0x07,
+	MSGPACK_OBJECT_BIN					= 0x08,
+	MSGPACK_OBJECT_EXT					= 0x09,
+	MSGPACK_OBJECT_FLOAT				= 0x0a,  /* via.dec, packed as float */
 } msgpack_object_type;
 
 
@@ -51,11 +54,24 @@ typedef struct {
 	struct msgpack_object_kv* ptr;
 } msgpack_object_map;
 
+/* raw of the old spec or str of the new one */
 typedef struct {
 	uint32_t size;
 	const char* ptr;
 } msgpack_object_raw;
 
+typedef struct {
+	uint32_t size;
+	const char* ptr;
+} msgpack_object_bin;
+
+/* application-defined type; negative types are reserved by the spec */
+typedef struct {
+	int8_t type;
+	uint32_t size;
+	const char* ptr;
+} msgpack_object_ext;
+
 typedef union {
 	bool boolean;
 	uint64_t u64;
@@ -64,6 +80,8 @@ typedef union {
 	msgpack_object_array array;
 	msgpack_object_map map;
 	msgpack_object_raw raw;
+	msgpack_object_bin bin;
+	msgpack_object_ext ext;
 } msgpack_object_union;
 
 typedef struct msgpack_object {
@@ -43,6 +43,9 @@ namespace type {
 		RAW					= MSGPACK_OBJECT_RAW,
 		ARRAY				= MSGPACK_OBJECT_ARRAY,
 		MAP					= MSGPACK_OBJECT_MAP,
+		BIN					= MSGPACK_OBJECT_BIN,
+		EXT					= MSGPACK_OBJECT_EXT,
+		FLOAT				= MSGPACK_OBJECT_FLOAT,
 	};
 }
 
@@ -65,6 +68,17 @@ struct object_raw {
 	const char* ptr;
 };
 
+struct object_bin {
+	uint32_t size;
+	const char* ptr;
+};
+
+struct object_ext {
+	int8_t type;
+	uint32_t size;
+	const char* ptr;
+};
+
 struct object {
 	union union_type {
 		bool boolean;
@@ -75,6 +89,8 @@ struct object {
 		object_map map;
 		object_raw raw;
 		object_raw ref;  // obsolete
+		object_bin bin;
+		object_ext ext;
 	};
 
 	type::object_type type;
@@ -156,6 +172,19 @@ template <typename T>
 void operator<< (object::with_zone& o, const T& v);
 
 
+namespace type {
+	// upper bound of the serialized size of T in bytes;
+	// 0 means that the size is not bounded at compile time.
+	template <typename T>
+	struct max_packed_size {
+		enum { value = 0 };
+	};
+
+	template <typename T>
+	struct max_packed_size<const T> : max_packed_size<T> { };
+}
+
+
 struct object::implicit_type {
 	implicit_type(object o) : obj(o) { }
 	~implicit_type() { }
@@ -374,11 +403,37 @@ packer<Stream>& operator<< (packer<Stream>& o, const object& v)
 		o.pack_double(v.via.dec);
 		return o;
 
+	case type::FLOAT:
+		o.pack_float((float)v.via.dec);
+		return o;
+
 	case type::RAW:
-		o.pack_raw(v.via.raw.size);
+		if(o.compat()) {
+			o.pack_raw(v.via.raw.size);
+		} else {
+			o.pack_str(v.via.raw.size);
+		}
 		o.pack_raw_body(v.via.raw.ptr, v.via.raw.size);
 		return o;
 
+	case type::BIN:
+		if(o.compat()) {
+			o.pack_raw(v.via.bin.size);
+		} else {
+			o.pack_bin(v.via.bin.size);
+		}
+		o.pack_bin_body(v.via.bin.ptr, v.via.bin.size);
+		return o;
+
+	case type::EXT:
+		if(o.compat()) {
+			// no ext in the old spec
+			throw type_error();
+		}
+		o.pack_ext(v.via.ext.size, v.via.ext.type);
+		o.pack_ext_body(v.via.ext.ptr, v.via.ext.size);
+		return o;
+
 	case type::ARRAY:
 		o.pack_array(v.via.array.size);
 		for(object* p(v.via.array.ptr),
@@ -71,8 +71,22 @@ static int msgpack_pack_map(msgpack_packer* pk, unsigned int n);
 static int msgpack_pack_raw(msgpack_packer* pk, size_t l);
 static int msgpack_pack_raw_body(msgpack_packer* pk, const void* b, size_t l);
 
+static int msgpack_pack_str(msgpack_packer* pk, size_t l);
+static int msgpack_pack_str_body(msgpack_packer* pk, const void* b, size_t l);
+
+static int msgpack_pack_bin(msgpack_packer* pk, size_t l);
+static int msgpack_pack_bin_body(msgpack_packer* pk, const void* b, size_t l);
+
+static int msgpack_pack_ext(msgpack_packer* pk, size_t l, int8_t type);
+static int msgpack_pack_ext_body(msgpack_packer* pk, const void* b, size_t l);
+
+/* packs raw objects as str and bin objects as bin */
 int msgpack_pack_object(msgpack_packer* pk, msgpack_object d);
 
+/* packs raw and bin objects as raw, for peers of the old spec; fails on
+ * ext objects */
+int msgpack_pack_object_compat(msgpack_packer* pk, msgpack_object d);
+
 
 
 #define msgpack_pack_inline_func(name) \
@@ -86,6 +100,9 @@ int msgpack_pack_object(msgpack_packer* pk, msgpack_object d);
 #define msgpack_pack_append_buffer(user, buf, len) \
 	return (*(user)->callback)((user)->data, (const char*)buf, len)
 
+/* the callback takes any length, so integers can be encoded branch-light */
+#define msgpack_pack_int_by_clz
+
 #include "msgpack/pack_template.h"
 
 inline void msgpack_packer_init(msgpack_packer* pk, void* data, msgpack_packer_write callback)
@@ -68,6 +68,32 @@ public:
 	packer<Stream>& pack_raw(size_t l);
 	packer<Stream>& pack_raw_body(const char* b, size_t l);
 
+	/*! new spec; peers of the old spec can't read str of 32 to 255 bytes
+	 *  nor any bin */
+	packer<Stream>& pack_str(size_t l);
+	packer<Stream>& pack_str_body(const char* b, size_t l);
+	packer<Stream>& pack_bin(size_t l);
+	packer<Stream>& pack_bin_body(const char* b, size_t l);
+	packer<Stream>& pack_ext(size_t l, int8_t type);
+	packer<Stream>& pack_ext_body(const char* b, size_t l);
+
+	/*! std::string, type::raw_ref and RAW objects pack as str, and BIN
+	 *  objects as bin, as msgpack_pack_object() does. In compat mode they
+	 *  all pack as raw, and EXT objects throw type_error, as
+	 *  msgpack_pack_object_compat() does. */
+	packer<Stream>& set_compat(bool compat);
+	bool compat() const;
+
+	/*! pack `v' whose encoded size never exceeds N bytes with unchecked
+	 *  stores and a single write to the stream */
+	template <size_t N, typename T>
+	packer<Stream>& pack_fixed(const T& v);
+
+	/*! pack each element of [p, pend) like pack_fixed<N>, batching the
+	 *  writes to the stream */
+	template <size_t N, typename T>
+	packer<Stream>& pack_fixed_range(const T* p, const T* pend);
+
 private:
 	static void _pack_uint8(Stream& x, uint8_t d);
 	static void _pack_uint16(Stream& x, uint16_t d);
@@ -101,17 +127,82 @@ private:
 	static void _pack_raw(Stream& x, size_t l);
 	static void _pack_raw_body(Stream& x, const void* b, size_t l);
 
+	static void _pack_str(Stream& x, size_t l);
+	static void _pack_str_body(Stream& x, const void* b, size_t l);
+	static void _pack_bin(Stream& x, size_t l);
+	static void _pack_bin_body(Stream& x, const void* b, size_t l);
+	static void _pack_ext(Stream& x, size_t l, int8_t type);
+	static void _pack_ext_body(Stream& x, const void* b, size_t l);
+
 	static void append_buffer(Stream& x, const unsigned char* buf, unsigned int len)
 		{ x.write((const char*)buf, len); }
 
 private:
 	Stream& m_stream;
+	bool m_compat;
 
 private:
 	packer();
 };
 
 
+namespace detail {
+	// Stream that writes to the memory starting at `ptr' without checking
+	// its capacity. It is parameterized by the real stream only so that
+	// every stream gets its own (inlinable) instantiation of the packer.
+	template <typename Stream>
+	struct unchecked_writer {
+		unchecked_writer(char* p) : ptr(p) { }
+
+		void write(const char* buf, unsigned int len)
+		{
+			memcpy(ptr, buf, len);
+			ptr += len;
+		}
+
+		char* ptr;
+	};
+
+	// Packs a value of bounded size into a stack buffer and appends it to
+	// the stream at once. Streams that can expose their free space
+	// specialize this to pack in place (see sbuffer.hpp). Streams whose
+	// write() may keep a reference to the buffer instead of copying it
+	// specialize append(), as the stack buffer is gone once the value is
+	// packed (see vrefbuffer.hpp).
+	template <typename Stream>
+	struct fixed_writer {
+		static void append(Stream& s, const char* buf, size_t len)
+		{
+			s.write(buf, len);
+		}
+
+		template <size_t N, typename T>
+		static void pack(Stream& s, const T& v)
+		{
+			char buf[N];
+			unchecked_writer<Stream> w(buf);
+			packer< unchecked_writer<Stream> >(w).pack(v);
+			append(s, buf, w.ptr - buf);
+		}
+
+		template <size_t N, typename T>
+		static void pack_range(Stream& s, const T* p, const T* const pend)
+		{
+			char buf[N < 4096 ? 4096 : N];
+			while(p < pend) {
+				unchecked_writer<Stream> w(buf);
+				packer< unchecked_writer<Stream> > pk(w);
+				do {
+					pk.pack(*p);
+					++p;
+				} while(p < pend && (size_t)(buf + sizeof(buf) - w.ptr) >= N);
+				append(s, buf, w.ptr - buf);
+			}
+		}
+	};
+}  // namespace detail
+
+
 template <typename Stream, typename T>
 inline void pack(Stream* s, const T& v)
 {
@@ -141,10 +232,10 @@ inline void pack(Stream& s, const T& v)
 
 
 template <typename Stream>
-packer<Stream>::packer(Stream* s) : m_stream(*s) { }
+packer<Stream>::packer(Stream* s) : m_stream(*s), m_compat(false) { }
 
 template <typename Stream>
-packer<Stream>::packer(Stream& s) : m_stream(s) { }
+packer<Stream>::packer(Stream& s) : m_stream(s), m_compat(false) { }
 
 template <typename Stream>
 packer<Stream>::~packer() { }
@@ -256,6 +347,50 @@ inline packer<Stream>& packer<Stream>::pack_raw_body(const char* b, size_t l)
 { _pack_raw_body(m_stream, b, l); return *this; }
 
 
+template <typename Stream>
+inline packer<Stream>& packer<Stream>::pack_str(size_t l)
+{ _pack_str(m_stream, l); return *this; }
+
+template <typename Stream>
+inline packer<Stream>& packer<Stream>::pack_str_body(const char* b, size_t l)
+{ _pack_str_body(m_stream, b, l); return *this; }
+
+template <typename Stream>
+inline packer<Stream>& packer<Stream>::pack_bin(size_t l)
+{ _pack_bin(m_stream, l); return *this; }
+
+template <typename Stream>
+inline packer<Stream>& packer<Stream>::pack_bin_body(const char* b, size_t l)
+{ _pack_bin_body(m_stream, b, l); return *this; }
+
+template <typename Stream>
+inline packer<Stream>& packer<Stream>::pack_ext(size_t l, int8_t type)
+{ _pack_ext(m_stream, l, type); return *this; }
+
+template <typename Stream>
+inline packer<Stream>& packer<Stream>::pack_ext_body(const char* b, size_t l)
+{ _pack_ext_body(m_stream, b, l); return *this; }
+
+template <typename Stream>
+inline packer<Stream>& packer<Stream>::set_compat(bool compat)
+{ m_compat = compat; return *this; }
+
+template <typename Stream>
+inline bool packer<Stream>::compat() const
+{ return m_compat; }
+
+
+template <typename Stream>
+template <size_t N, typename T>
+inline packer<Stream>& packer<Stream>::pack_fixed(const T& v)
+{ detail::fixed_writer<Stream>::template pack<N>(m_stream, v); return *this; }
+
+template <typename Stream>
+template <size_t N, typename T>
+inline packer<Stream>& packer<Stream>::pack_fixed_range(const T* p, const T* pend)
+{ detail::fixed_writer<Stream>::template pack_range<N>(m_stream, p, pend); return *this; }
+
+
 }  // namespace msgpack
 
 #endif /* msgpack/pack.hpp */
@@ -74,6 +74,55 @@ do { \
 	} \
 } while(0)
 
+/*
+ * If msgpack_pack_int_by_clz is defined, integers wider than 16 bits pick
+ * their encoding from the count of leading zeros instead of a chain of
+ * comparisons (unless MSGPACK_PACK_NO_CLZ is defined). `bits' is the
+ * number of bits d needs, including the sign bit for signed encodings; the
+ * value is stored big-endian from the top of a 64-bit word so that every
+ * width takes the same path. This only pays off when appending a buffer
+ * costs the same for any length; streams that the compiler sees through
+ * copy fixed sizes faster.
+ */
+#if defined(msgpack_pack_int_by_clz) && !defined(MSGPACK_PACK_NO_CLZ) && defined(__GNUC__)
+#define USE_CLZ_INT
+#endif
+
+#ifdef USE_CLZ_INT
+#define msgpack_pack_real_clz(x, d, bits, type) \
+do { \
+	const unsigned int b_ = (bits); \
+	const unsigned int cls_ = (b_ > 8) + (b_ > 16) + (b_ > 32); \
+	const unsigned int len_ = 1u << cls_; \
+	unsigned char buf[9]; \
+	buf[0] = (type) + cls_; \
+	_msgpack_store64(&buf[1], (uint64_t)(d) << (64 - 8*len_)); \
+	msgpack_pack_append_buffer(x, buf, 1 + len_); \
+} while(0)
+
+#define msgpack_pack_real_uint32(x, d) \
+do { \
+	if(d < (1<<7)) { \
+		/* fixnum */ \
+		msgpack_pack_append_buffer(x, &TAKE8_32(d), 1); \
+	} else { \
+		/* unsigned 8, 16 or 32 */ \
+		msgpack_pack_real_clz(x, d, 32 - __builtin_clz(d), 0xcc); \
+	} \
+} while(0)
+
+#define msgpack_pack_real_uint64(x, d) \
+do { \
+	if(d < (1<<7)) { \
+		/* fixnum */ \
+		msgpack_pack_append_buffer(x, &TAKE8_64(d), 1); \
+	} else { \
+		/* unsigned 8, 16, 32 or 64 */ \
+		msgpack_pack_real_clz(x, d, 64 - __builtin_clzll(d), 0xcc); \
+	} \
+} while(0)
+
+#else
 #define msgpack_pack_real_uint32(x, d) \
 do { \
 	if(d < (1<<8)) { \
@@ -131,6 +180,8 @@ do { \
 	} \
 } while(0)
 
+#endif
+
 #define msgpack_pack_real_int8(x, d) \
 do { \
 	if(d < -(1<<5)) { \
@@ -173,6 +224,36 @@ do { \
 	} \
 } while(0)
 
+#ifdef USE_CLZ_INT
+#define msgpack_pack_real_int32(x, d) \
+do { \
+	if(d < -(1<<5)) { \
+		/* signed 8, 16 or 32 */ \
+		msgpack_pack_real_clz(x, d, 33 - __builtin_clz(~(uint32_t)d), 0xd0); \
+	} else if(d < (1<<7)) { \
+		/* fixnum */ \
+		msgpack_pack_append_buffer(x, &TAKE8_32(d), 1); \
+	} else { \
+		/* unsigned 8, 16 or 32 */ \
+		msgpack_pack_real_clz(x, d, 32 - __builtin_clz(d), 0xcc); \
+	} \
+} while(0)
+
+#define msgpack_pack_real_int64(x, d) \
+do { \
+	if(d < -(1LL<<5)) { \
+		/* signed 8, 16, 32 or 64 */ \
+		msgpack_pack_real_clz(x, d, 65 - __builtin_clzll(~(uint64_t)d), 0xd0); \
+	} else if(d < (1<<7)) { \
+		/* fixnum */ \
+		msgpack_pack_append_buffer(x, &TAKE8_64(d), 1); \
+	} else { \
+		/* unsigned 8, 16, 32 or 64 */ \
+		msgpack_pack_real_clz(x, d, 64 - __builtin_clzll(d), 0xcc); \
+	} \
+} while(0)
+
+#else
 #define msgpack_pack_real_int32(x, d) \
 do { \
 	if(d < -(1<<5)) { \
@@ -270,6 +351,7 @@ do { \
 		} \
 	} \
 } while(0)
+#endif
 
 
 #ifdef msgpack_pack_inline_func_fastint
@@ -746,6 +828,97 @@ msgpack_pack_inline_func(_raw_body)(msgpack_pack_user x, const void* b, size_t l
 	msgpack_pack_append_buffer(x, (const unsigned char*)b, l);
 }
 
+
+/*
+ * Str and Bin
+ *
+ * Str is Raw with a shorter header for 32 to 255 bytes, which peers of
+ * the old spec can't read. Bin can't be told apart from Str only by them.
+ */
+
+msgpack_pack_inline_func(_str)(msgpack_pack_user x, size_t l)
+{
+	if(l < 32) {
+		unsigned char d = 0xa0 | l;
+		msgpack_pack_append_buffer(x, &TAKE8_8(d), 1);
+	} else if(l < 256) {
+		unsigned char buf[2];
+		buf[0] = 0xd9; buf[1] = (uint8_t)l;
+		msgpack_pack_append_buffer(x, buf, 2);
+	} else if(l < 65536) {
+		unsigned char buf[3];
+		buf[0] = 0xda; _msgpack_store16(&buf[1], l);
+		msgpack_pack_append_buffer(x, buf, 3);
+	} else {
+		unsigned char buf[5];
+		buf[0] = 0xdb; _msgpack_store32(&buf[1], l);
+		msgpack_pack_append_buffer(x, buf, 5);
+	}
+}
+
+msgpack_pack_inline_func(_str_body)(msgpack_pack_user x, const void* b, size_t l)
+{
+	msgpack_pack_append_buffer(x, (const unsigned char*)b, l);
+}
+
+msgpack_pack_inline_func(_bin)(msgpack_pack_user x, size_t l)
+{
+	if(l < 256) {
+		unsigned char buf[2];
+		buf[0] = 0xc4; buf[1] = (uint8_t)l;
+		msgpack_pack_append_buffer(x, buf, 2);
+	} else if(l < 65536) {
+		unsigned char buf[3];
+		buf[0] = 0xc5; _msgpack_store16(&buf[1], l);
+		msgpack_pack_append_buffer(x, buf, 3);
+	} else {
+		unsigned char buf[5];
+		buf[0] = 0xc6; _msgpack_store32(&buf[1], l);
+		msgpack_pack_append_buffer(x, buf, 5);
+	}
+}
+
+msgpack_pack_inline_func(_bin_body)(msgpack_pack_user x, const void* b, size_t l)
+{
+	msgpack_pack_append_buffer(x, (const unsigned char*)b, l);
+}
+
+
+/*
+ * Ext
+ */
+
+msgpack_pack_inline_func(_ext)(msgpack_pack_user x, size_t l, int8_t type)
+{
+	// fixext 1, 2, 4, 8 and 16
+	static const unsigned char fixext[17] = {
+		0, 0xd4, 0xd5, 0, 0xd6, 0, 0, 0, 0xd7,
+		0, 0, 0, 0, 0, 0, 0, 0xd8 };
+
+	if(l <= 16 && fixext[l] != 0) {
+		unsigned char buf[2];
+		buf[0] = fixext[l]; buf[1] = (unsigned char)type;
+		msgpack_pack_append_buffer(x, buf, 2);
+	} else if(l < 256) {
+		unsigned char buf[3];
+		buf[0] = 0xc7; buf[1] = (uint8_t)l; buf[2] = (unsigned char)type;
+		msgpack_pack_append_buffer(x, buf, 3);
+	} else if(l < 65536) {
+		unsigned char buf[4];
+		buf[0] = 0xc8; _msgpack_store16(&buf[1], l); buf[3] = (unsigned char)type;
+		msgpack_pack_append_buffer(x, buf, 4);
+	} else {
+		unsigned char buf[6];
+		buf[0] = 0xc9; _msgpack_store32(&buf[1], l); buf[5] = (unsigned char)type;
+		msgpack_pack_append_buffer(x, buf, 6);
+	}
+}
+
+msgpack_pack_inline_func(_ext_body)(msgpack_pack_user x, const void* b, size_t l)
+{
+	msgpack_pack_append_buffer(x, (const unsigned char*)b, l);
+}
+
 #undef msgpack_pack_inline_func
 #undef msgpack_pack_user
 #undef msgpack_pack_append_buffer
@@ -763,4 +936,8 @@ msgpack_pack_inline_func(_raw_body)(msgpack_pack_user x, const void* b, size_t l
 #undef msgpack_pack_real_int16
 #undef msgpack_pack_real_int32
 #undef msgpack_pack_real_int64
+#undef msgpack_pack_real_clz
+
+#undef msgpack_pack_int_by_clz
+#undef USE_CLZ_INT
 
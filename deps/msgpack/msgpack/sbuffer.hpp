@@ -19,6 +19,7 @@
 #define MSGPACK_SBUFFER_HPP__
 
 #include "msgpack/sbuffer.h"
+#include "msgpack/pack.hpp"
 #include <stdexcept>
 
 namespace msgpack {
@@ -44,12 +45,18 @@ public:
 
 public:
 	void write(const char* buf, unsigned int len)
+	{
+		reserve(len);
+		memcpy(base::data + base::size, buf, len);
+		base::size += len;
+	}
+
+	/*! make room for at least `len' more bytes */
+	void reserve(size_t len)
 	{
 		if(base::alloc - base::size < len) {
 			expand_buffer(len);
 		}
-		memcpy(base::data + base::size, buf, len);
-		base::size += len;
 	}
 
 	char* data()
@@ -97,6 +104,41 @@ private:
 };
 
 
+namespace detail {
+	template <>
+	struct fixed_writer<sbuffer> {
+		template <size_t N, typename T>
+		static void pack(sbuffer& s, const T& v)
+		{
+			s.reserve(N);
+			msgpack_sbuffer& b = s;
+			unchecked_writer<sbuffer> w(b.data + b.size);
+			packer< unchecked_writer<sbuffer> >(w).pack(v);
+			b.size = w.ptr - b.data;
+		}
+
+		template <size_t N, typename T>
+		static void pack_range(sbuffer& s, const T* p, const T* const pend)
+		{
+			// reserve chunk by chunk so that small encodings of wide
+			// types don't over-allocate for large ranges
+			const size_t chunk = N < 65536 ? 65536 / N : 1;
+			msgpack_sbuffer& b = s;
+			while(p < pend) {
+				const T* const cend = (size_t)(pend - p) > chunk ? p + chunk : pend;
+				s.reserve((cend - p) * N);
+				unchecked_writer<sbuffer> w(b.data + b.size);
+				packer< unchecked_writer<sbuffer> > pk(w);
+				for(; p < cend; ++p) {
+					pk.pack(*p);
+				}
+				b.size = w.ptr - b.data;
+			}
+		}
+	};
+}  // namespace detail
+
+
 }  // namespace msgpack
 
 #endif /* msgpack/sbuffer.hpp */
@@ -45,6 +45,27 @@ typedef unsigned int _msgpack_atomic_counter_t;
 #define _msgpack_sync_incr_and_fetch(ptr) __sync_add_and_fetch(ptr, 1)
 #endif
 
+/* compare-and-swap and acquire/release access for size_t */
+#ifdef _WIN32
+#define _msgpack_sync_bool_compare_and_swap(ptr, oldval, newval) \
+	(InterlockedCompareExchangePointer((PVOID volatile*)(ptr), \
+			(PVOID)(newval), (PVOID)(oldval)) == (PVOID)(oldval))
+/* volatile accesses have acquire/release semantics on MSVC */
+#define _msgpack_load_acquire(ptr) (*(ptr))
+#define _msgpack_store_release(ptr, val) (*(ptr) = (val))
+#else
+#define _msgpack_sync_bool_compare_and_swap(ptr, oldval, newval) \
+	__sync_bool_compare_and_swap(ptr, oldval, newval)
+#if defined(__ATOMIC_ACQUIRE)
+#define _msgpack_load_acquire(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define _msgpack_store_release(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#else
+#define _msgpack_load_acquire(ptr) __sync_fetch_and_add(ptr, 0)
+#define _msgpack_store_release(ptr, val) \
+	do { __sync_synchronize(); *(ptr) = (val); } while(0)
+#endif
+#endif
+
 
 #ifdef _WIN32
 #include <winsock2.h>
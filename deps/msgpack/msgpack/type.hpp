@@ -12,4 +12,5 @@
 #include "msgpack/type/vector.hpp"
 #include "msgpack/type/tuple.hpp"
 #include "msgpack/type/define.hpp"
+#include "msgpack/type/define_map.hpp"
 
@@ -24,6 +24,14 @@
 namespace msgpack {
 
 
+namespace type {
+
+template <> struct max_packed_size<bool>
+	{ enum { value = 1 }; };
+
+}  // namespace type
+
+
 inline bool& operator>> (object o, bool& v)
 {
 	if(o.type != type::BOOLEAN) { throw type_error(); }
@@ -22,7 +22,7 @@
 	template <typename Packer> \
 	void msgpack_pack(Packer& pk) const \
 	{ \
-		msgpack::type::make_define(__VA_ARGS__).msgpack_pack(pk); \
+		msgpack::type::pack_define(pk, msgpack::type::make_define(__VA_ARGS__)); \
 	} \
 	void msgpack_unpack(msgpack::object o) \
 	{ \
@@ -3271,6 +3271,158 @@ define<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16
 }
 
 
+namespace detail {
+	template <typename T>
+	struct define_field {
+		enum {
+			count = 1,
+			size = max_packed_size<T>::value,
+			bounded = (max_packed_size<T>::value != 0)
+		};
+	};
+
+	template <>
+	struct define_field<void> {
+		enum { count = 0, size = 0, bounded = 1 };
+	};
+
+	template <typename Define, bool Bounded>
+	struct define_packer {
+		template <typename Packer>
+		static void pack(Packer& pk, const Define& d)
+		{
+			d.msgpack_pack(pk);
+		}
+	};
+
+	template <typename Define>
+	struct define_packer<Define, true> {
+		template <typename Packer>
+		static void pack(Packer& pk, const Define& d)
+		{
+			pk.template pack_fixed<max_packed_size<Define>::value>(d);
+		}
+	};
+}  // namespace detail
+
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27, typename A28, typename A29, typename A30, typename A31>
+struct max_packed_size< define<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29, A30, A31> > {
+	enum {
+		count =
+			detail::define_field<A0>::count +
+			detail::define_field<A1>::count +
+			detail::define_field<A2>::count +
+			detail::define_field<A3>::count +
+			detail::define_field<A4>::count +
+			detail::define_field<A5>::count +
+			detail::define_field<A6>::count +
+			detail::define_field<A7>::count +
+			detail::define_field<A8>::count +
+			detail::define_field<A9>::count +
+			detail::define_field<A10>::count +
+			detail::define_field<A11>::count +
+			detail::define_field<A12>::count +
+			detail::define_field<A13>::count +
+			detail::define_field<A14>::count +
+			detail::define_field<A15>::count +
+			detail::define_field<A16>::count +
+			detail::define_field<A17>::count +
+			detail::define_field<A18>::count +
+			detail::define_field<A19>::count +
+			detail::define_field<A20>::count +
+			detail::define_field<A21>::count +
+			detail::define_field<A22>::count +
+			detail::define_field<A23>::count +
+			detail::define_field<A24>::count +
+			detail::define_field<A25>::count +
+			detail::define_field<A26>::count +
+			detail::define_field<A27>::count +
+			detail::define_field<A28>::count +
+			detail::define_field<A29>::count +
+			detail::define_field<A30>::count +
+			detail::define_field<A31>::count,
+		bounded =
+			detail::define_field<A0>::bounded &&
+			detail::define_field<A1>::bounded &&
+			detail::define_field<A2>::bounded &&
+			detail::define_field<A3>::bounded &&
+			detail::define_field<A4>::bounded &&
+			detail::define_field<A5>::bounded &&
+			detail::define_field<A6>::bounded &&
+			detail::define_field<A7>::bounded &&
+			detail::define_field<A8>::bounded &&
+			detail::define_field<A9>::bounded &&
+			detail::define_field<A10>::bounded &&
+			detail::define_field<A11>::bounded &&
+			detail::define_field<A12>::bounded &&
+			detail::define_field<A13>::bounded &&
+			detail::define_field<A14>::bounded &&
+			detail::define_field<A15>::bounded &&
+			detail::define_field<A16>::bounded &&
+			detail::define_field<A17>::bounded &&
+			detail::define_field<A18>::bounded &&
+			detail::define_field<A19>::bounded &&
+			detail::define_field<A20>::bounded &&
+			detail::define_field<A21>::bounded &&
+			detail::define_field<A22>::bounded &&
+			detail::define_field<A23>::bounded &&
+			detail::define_field<A24>::bounded &&
+			detail::define_field<A25>::bounded &&
+			detail::define_field<A26>::bounded &&
+			detail::define_field<A27>::bounded &&
+			detail::define_field<A28>::bounded &&
+			detail::define_field<A29>::bounded &&
+			detail::define_field<A30>::bounded &&
+			detail::define_field<A31>::bounded,
+		value = !bounded ? 0 :
+			(count < 16 ? 1 : 3) +
+			detail::define_field<A0>::size +
+			detail::define_field<A1>::size +
+			detail::define_field<A2>::size +
+			detail::define_field<A3>::size +
+			detail::define_field<A4>::size +
+			detail::define_field<A5>::size +
+			detail::define_field<A6>::size +
+			detail::define_field<A7>::size +
+			detail::define_field<A8>::size +
+			detail::define_field<A9>::size +
+			detail::define_field<A10>::size +
+			detail::define_field<A11>::size +
+			detail::define_field<A12>::size +
+			detail::define_field<A13>::size +
+			detail::define_field<A14>::size +
+			detail::define_field<A15>::size +
+			detail::define_field<A16>::size +
+			detail::define_field<A17>::size +
+			detail::define_field<A18>::size +
+			detail::define_field<A19>::size +
+			detail::define_field<A20>::size +
+			detail::define_field<A21>::size +
+			detail::define_field<A22>::size +
+			detail::define_field<A23>::size +
+			detail::define_field<A24>::size +
+			detail::define_field<A25>::size +
+			detail::define_field<A26>::size +
+			detail::define_field<A27>::size +
+			detail::define_field<A28>::size +
+			detail::define_field<A29>::size +
+			detail::define_field<A30>::size +
+			detail::define_field<A31>::size
+	};
+};
+
+
+// Packs all fields of `d' with unchecked stores and a single write to the
+// stream if their encoded size is bounded at compile time; otherwise packs
+// them token by token.
+template <typename Packer, typename Define>
+inline void pack_define(Packer& pk, const Define& d)
+{
+	detail::define_packer<Define, max_packed_size<Define>::value != 0>::pack(pk, d);
+}
+
+
 }  // namespace type
 }  // namespace msgpack
 
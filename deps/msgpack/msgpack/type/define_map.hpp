@@ -0,0 +1,4069 @@
+//
+// MessagePack for C++ static resolution routine
+//
+// Copyright (C) 2008-2009 FURUHASHI Sadayuki
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef MSGPACK_TYPE_DEFINE_MAP_HPP__
+#define MSGPACK_TYPE_DEFINE_MAP_HPP__
+
+#include "msgpack/object.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef MSGPACK_DEFINE_MAP_MAX_TABLE
+#define MSGPACK_DEFINE_MAP_MAX_TABLE 65536
+#endif
+
+// Like MSGPACK_DEFINE, but serializes the fields as a map keyed by their
+// names. Unknown keys are ignored and missing fields are left untouched
+// when unpacking. Only plain member names can be listed.
+#define MSGPACK_DEFINE_MAP(...) \
+	static const msgpack::type::define_map_keys& msgpack_map_keys() \
+	{ \
+		static const msgpack::type::define_map_keys keys(#__VA_ARGS__); \
+		return keys; \
+	} \
+	template <typename Packer> \
+	void msgpack_pack(Packer& pk) const \
+	{ \
+		msgpack::type::make_define_map(msgpack_map_keys(), __VA_ARGS__).msgpack_pack(pk); \
+	} \
+	void msgpack_unpack(msgpack::object o) \
+	{ \
+		msgpack::type::make_define_map(msgpack_map_keys(), __VA_ARGS__).msgpack_unpack(o); \
+	}\
+	template <typename MSGPACK_OBJECT> \
+	void msgpack_object(MSGPACK_OBJECT* o, msgpack::zone* z) const \
+	{ \
+		msgpack::type::make_define_map(msgpack_map_keys(), __VA_ARGS__).msgpack_object(o, z); \
+	}
+
+namespace msgpack {
+namespace type {
+
+
+// Field names of a MSGPACK_DEFINE_MAP type and a perfect hash over them.
+// It is built once per type from the stringized field list, so looking up
+// a key costs one hash and one compare and never allocates.
+class define_map_keys {
+public:
+	/*! throws std::invalid_argument if a name is listed twice, and
+	 *  std::length_error if no table of at most
+	 *  MSGPACK_DEFINE_MAP_MAX_TABLE slots separates the names */
+	define_map_keys(const char* list);
+
+public:
+	size_t size() const
+		{ return m_names.size(); }
+
+	/*! index of the field named by the key, or -1 */
+	int find(const char* p, size_t len) const;
+	int find(const object& key) const;
+
+	template <typename Packer>
+	void pack_key(Packer& pk, size_t i) const;
+
+	object key(size_t i) const;
+
+private:
+	static uint32_t hash(const char* p, size_t len, uint32_t seed);
+	bool build_table(size_t table_size, uint32_t seed);
+
+	std::vector<std::string> m_names;
+	std::vector<int> m_table;
+	uint32_t m_seed;
+	uint32_t m_mask;
+};
+
+
+inline define_map_keys::define_map_keys(const char* list) :
+	m_seed(0), m_mask(0)
+{
+	const char* p = list;
+	while(*p) {
+		while(*p == ' ' || *p == '\t' || *p == '\n') { ++p; }
+		const char* begin = p;
+		while(*p && *p != ',') { ++p; }
+		const char* end = p;
+		while(end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n')) { --end; }
+		if(end > begin) {
+			m_names.push_back(std::string(begin, end - begin));
+		}
+		if(*p == ',') { ++p; }
+	}
+
+	// equal names collide under every seed
+	for(size_t i = 0; i < m_names.size(); ++i) {
+		for(size_t j = i + 1; j < m_names.size(); ++j) {
+			if(m_names[i] == m_names[j]) {
+				throw std::invalid_argument("duplicate field in MSGPACK_DEFINE_MAP: " + m_names[i]);
+			}
+		}
+	}
+
+	size_t table_size = 1;
+	while(table_size < m_names.size() * 2) {
+		table_size *= 2;
+	}
+
+	for(; table_size <= MSGPACK_DEFINE_MAP_MAX_TABLE; table_size *= 2) {
+		for(uint32_t seed = 0; seed < 256; ++seed) {
+			if(build_table(table_size, seed)) {
+				return;
+			}
+		}
+	}
+	throw std::length_error("no perfect hash for the fields of MSGPACK_DEFINE_MAP");
+}
+
+inline bool define_map_keys::build_table(size_t table_size, uint32_t seed)
+{
+	m_table.assign(table_size, -1);
+	m_seed = seed;
+	m_mask = table_size - 1;
+	for(size_t i = 0; i < m_names.size(); ++i) {
+		const std::string& n = m_names[i];
+		int& slot = m_table[hash(n.data(), n.size(), m_seed) & m_mask];
+		if(slot >= 0) {
+			return false;
+		}
+		slot = (int)i;
+	}
+	return true;
+}
+
+inline uint32_t define_map_keys::hash(const char* p, size_t len, uint32_t seed)
+{
+	// FNV-1a
+	uint32_t h = 2166136261U ^ seed;
+	for(const char* const pend = p + len; p < pend; ++p) {
+		h ^= (unsigned char)*p;
+		h *= 16777619U;
+	}
+	return h;
+}
+
+inline int define_map_keys::find(const char* p, size_t len) const
+{
+	int i = m_table[hash(p, len, m_seed) & m_mask];
+	if(i < 0) {
+		return -1;
+	}
+	const std::string& n = m_names[i];
+	if(n.size() != len || memcmp(n.data(), p, len) != 0) {
+		return -1;
+	}
+	return i;
+}
+
+inline int define_map_keys::find(const object& key) const
+{
+	if(key.type != type::RAW) {
+		return -1;
+	}
+	return find(key.via.raw.ptr, key.via.raw.size);
+}
+
+template <typename Packer>
+inline void define_map_keys::pack_key(Packer& pk, size_t i) const
+{
+	const std::string& n = m_names[i];
+	if(pk.compat()) {
+		pk.pack_raw(n.size());
+	} else {
+		pk.pack_str(n.size());
+	}
+	pk.pack_raw_body(n.data(), n.size());
+}
+
+inline object define_map_keys::key(size_t i) const
+{
+	object o;
+	o.type = type::RAW;
+	o.via.raw.ptr = m_names[i].data();
+	o.via.raw.size = m_names[i].size();
+	return o;
+}
+
+
+template <typename A0 = void, typename A1 = void, typename A2 = void, typename A3 = void, typename A4 = void, typename A5 = void, typename A6 = void, typename A7 = void, typename A8 = void, typename A9 = void, typename A10 = void, typename A11 = void, typename A12 = void, typename A13 = void, typename A14 = void, typename A15 = void, typename A16 = void, typename A17 = void, typename A18 = void, typename A19 = void, typename A20 = void, typename A21 = void, typename A22 = void, typename A23 = void, typename A24 = void, typename A25 = void, typename A26 = void, typename A27 = void, typename A28 = void, typename A29 = void, typename A30 = void, typename A31 = void, typename A32 = void>
+struct define_map;
+
+
+template <typename A0>
+struct define_map<A0> {
+	define_map(const define_map_keys& _keys, A0& _a0) :
+		keys(_keys), a0(_a0) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(1);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*1);
+		o->via.map.size = 1;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+};
+
+template <typename A0, typename A1>
+struct define_map<A0, A1> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1) :
+		keys(_keys), a0(_a0), a1(_a1) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(2);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*2);
+		o->via.map.size = 2;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+};
+
+template <typename A0, typename A1, typename A2>
+struct define_map<A0, A1, A2> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(3);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*3);
+		o->via.map.size = 3;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+};
+
+template <typename A0, typename A1, typename A2, typename A3>
+struct define_map<A0, A1, A2, A3> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(4);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*4);
+		o->via.map.size = 4;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4>
+struct define_map<A0, A1, A2, A3, A4> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(5);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*5);
+		o->via.map.size = 5;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
+struct define_map<A0, A1, A2, A3, A4, A5> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(6);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*6);
+		o->via.map.size = 6;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+struct define_map<A0, A1, A2, A3, A4, A5, A6> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(7);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*7);
+		o->via.map.size = 7;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(8);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*8);
+		o->via.map.size = 8;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(9);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*9);
+		o->via.map.size = 9;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(10);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*10);
+		o->via.map.size = 10;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(11);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*11);
+		o->via.map.size = 11;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(12);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*12);
+		o->via.map.size = 12;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(13);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*13);
+		o->via.map.size = 13;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(14);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*14);
+		o->via.map.size = 14;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(15);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*15);
+		o->via.map.size = 15;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(16);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*16);
+		o->via.map.size = 16;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(17);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*17);
+		o->via.map.size = 17;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(18);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*18);
+		o->via.map.size = 18;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(19);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*19);
+		o->via.map.size = 19;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(20);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*20);
+		o->via.map.size = 20;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(21);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*21);
+		o->via.map.size = 21;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(22);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*22);
+		o->via.map.size = 22;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(23);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*23);
+		o->via.map.size = 23;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22, A23& _a23) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22), a23(_a23) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(24);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+		keys.pack_key(pk, 23); pk.pack(a23);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			case 23: p->val.convert(&a23); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*24);
+		o->via.map.size = 24;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+		o->via.map.ptr[23].key = keys.key(23);
+		o->via.map.ptr[23].val = object(a23, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+	A23& a23;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22, A23& _a23, A24& _a24) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22), a23(_a23), a24(_a24) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(25);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+		keys.pack_key(pk, 23); pk.pack(a23);
+		keys.pack_key(pk, 24); pk.pack(a24);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			case 23: p->val.convert(&a23); break;
+			case 24: p->val.convert(&a24); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*25);
+		o->via.map.size = 25;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+		o->via.map.ptr[23].key = keys.key(23);
+		o->via.map.ptr[23].val = object(a23, z);
+		o->via.map.ptr[24].key = keys.key(24);
+		o->via.map.ptr[24].val = object(a24, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+	A23& a23;
+	A24& a24;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22, A23& _a23, A24& _a24, A25& _a25) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22), a23(_a23), a24(_a24), a25(_a25) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(26);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+		keys.pack_key(pk, 23); pk.pack(a23);
+		keys.pack_key(pk, 24); pk.pack(a24);
+		keys.pack_key(pk, 25); pk.pack(a25);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			case 23: p->val.convert(&a23); break;
+			case 24: p->val.convert(&a24); break;
+			case 25: p->val.convert(&a25); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*26);
+		o->via.map.size = 26;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+		o->via.map.ptr[23].key = keys.key(23);
+		o->via.map.ptr[23].val = object(a23, z);
+		o->via.map.ptr[24].key = keys.key(24);
+		o->via.map.ptr[24].val = object(a24, z);
+		o->via.map.ptr[25].key = keys.key(25);
+		o->via.map.ptr[25].val = object(a25, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+	A23& a23;
+	A24& a24;
+	A25& a25;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22, A23& _a23, A24& _a24, A25& _a25, A26& _a26) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22), a23(_a23), a24(_a24), a25(_a25), a26(_a26) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(27);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+		keys.pack_key(pk, 23); pk.pack(a23);
+		keys.pack_key(pk, 24); pk.pack(a24);
+		keys.pack_key(pk, 25); pk.pack(a25);
+		keys.pack_key(pk, 26); pk.pack(a26);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			case 23: p->val.convert(&a23); break;
+			case 24: p->val.convert(&a24); break;
+			case 25: p->val.convert(&a25); break;
+			case 26: p->val.convert(&a26); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*27);
+		o->via.map.size = 27;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+		o->via.map.ptr[23].key = keys.key(23);
+		o->via.map.ptr[23].val = object(a23, z);
+		o->via.map.ptr[24].key = keys.key(24);
+		o->via.map.ptr[24].val = object(a24, z);
+		o->via.map.ptr[25].key = keys.key(25);
+		o->via.map.ptr[25].val = object(a25, z);
+		o->via.map.ptr[26].key = keys.key(26);
+		o->via.map.ptr[26].val = object(a26, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+	A23& a23;
+	A24& a24;
+	A25& a25;
+	A26& a26;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22, A23& _a23, A24& _a24, A25& _a25, A26& _a26, A27& _a27) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22), a23(_a23), a24(_a24), a25(_a25), a26(_a26), a27(_a27) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(28);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+		keys.pack_key(pk, 23); pk.pack(a23);
+		keys.pack_key(pk, 24); pk.pack(a24);
+		keys.pack_key(pk, 25); pk.pack(a25);
+		keys.pack_key(pk, 26); pk.pack(a26);
+		keys.pack_key(pk, 27); pk.pack(a27);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			case 23: p->val.convert(&a23); break;
+			case 24: p->val.convert(&a24); break;
+			case 25: p->val.convert(&a25); break;
+			case 26: p->val.convert(&a26); break;
+			case 27: p->val.convert(&a27); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*28);
+		o->via.map.size = 28;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+		o->via.map.ptr[23].key = keys.key(23);
+		o->via.map.ptr[23].val = object(a23, z);
+		o->via.map.ptr[24].key = keys.key(24);
+		o->via.map.ptr[24].val = object(a24, z);
+		o->via.map.ptr[25].key = keys.key(25);
+		o->via.map.ptr[25].val = object(a25, z);
+		o->via.map.ptr[26].key = keys.key(26);
+		o->via.map.ptr[26].val = object(a26, z);
+		o->via.map.ptr[27].key = keys.key(27);
+		o->via.map.ptr[27].val = object(a27, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+	A23& a23;
+	A24& a24;
+	A25& a25;
+	A26& a26;
+	A27& a27;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27, typename A28>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22, A23& _a23, A24& _a24, A25& _a25, A26& _a26, A27& _a27, A28& _a28) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22), a23(_a23), a24(_a24), a25(_a25), a26(_a26), a27(_a27), a28(_a28) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(29);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+		keys.pack_key(pk, 23); pk.pack(a23);
+		keys.pack_key(pk, 24); pk.pack(a24);
+		keys.pack_key(pk, 25); pk.pack(a25);
+		keys.pack_key(pk, 26); pk.pack(a26);
+		keys.pack_key(pk, 27); pk.pack(a27);
+		keys.pack_key(pk, 28); pk.pack(a28);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			case 23: p->val.convert(&a23); break;
+			case 24: p->val.convert(&a24); break;
+			case 25: p->val.convert(&a25); break;
+			case 26: p->val.convert(&a26); break;
+			case 27: p->val.convert(&a27); break;
+			case 28: p->val.convert(&a28); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*29);
+		o->via.map.size = 29;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+		o->via.map.ptr[23].key = keys.key(23);
+		o->via.map.ptr[23].val = object(a23, z);
+		o->via.map.ptr[24].key = keys.key(24);
+		o->via.map.ptr[24].val = object(a24, z);
+		o->via.map.ptr[25].key = keys.key(25);
+		o->via.map.ptr[25].val = object(a25, z);
+		o->via.map.ptr[26].key = keys.key(26);
+		o->via.map.ptr[26].val = object(a26, z);
+		o->via.map.ptr[27].key = keys.key(27);
+		o->via.map.ptr[27].val = object(a27, z);
+		o->via.map.ptr[28].key = keys.key(28);
+		o->via.map.ptr[28].val = object(a28, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+	A23& a23;
+	A24& a24;
+	A25& a25;
+	A26& a26;
+	A27& a27;
+	A28& a28;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27, typename A28, typename A29>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22, A23& _a23, A24& _a24, A25& _a25, A26& _a26, A27& _a27, A28& _a28, A29& _a29) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22), a23(_a23), a24(_a24), a25(_a25), a26(_a26), a27(_a27), a28(_a28), a29(_a29) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(30);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+		keys.pack_key(pk, 23); pk.pack(a23);
+		keys.pack_key(pk, 24); pk.pack(a24);
+		keys.pack_key(pk, 25); pk.pack(a25);
+		keys.pack_key(pk, 26); pk.pack(a26);
+		keys.pack_key(pk, 27); pk.pack(a27);
+		keys.pack_key(pk, 28); pk.pack(a28);
+		keys.pack_key(pk, 29); pk.pack(a29);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			case 23: p->val.convert(&a23); break;
+			case 24: p->val.convert(&a24); break;
+			case 25: p->val.convert(&a25); break;
+			case 26: p->val.convert(&a26); break;
+			case 27: p->val.convert(&a27); break;
+			case 28: p->val.convert(&a28); break;
+			case 29: p->val.convert(&a29); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*30);
+		o->via.map.size = 30;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+		o->via.map.ptr[23].key = keys.key(23);
+		o->via.map.ptr[23].val = object(a23, z);
+		o->via.map.ptr[24].key = keys.key(24);
+		o->via.map.ptr[24].val = object(a24, z);
+		o->via.map.ptr[25].key = keys.key(25);
+		o->via.map.ptr[25].val = object(a25, z);
+		o->via.map.ptr[26].key = keys.key(26);
+		o->via.map.ptr[26].val = object(a26, z);
+		o->via.map.ptr[27].key = keys.key(27);
+		o->via.map.ptr[27].val = object(a27, z);
+		o->via.map.ptr[28].key = keys.key(28);
+		o->via.map.ptr[28].val = object(a28, z);
+		o->via.map.ptr[29].key = keys.key(29);
+		o->via.map.ptr[29].val = object(a29, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+	A23& a23;
+	A24& a24;
+	A25& a25;
+	A26& a26;
+	A27& a27;
+	A28& a28;
+	A29& a29;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27, typename A28, typename A29, typename A30>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29, A30> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22, A23& _a23, A24& _a24, A25& _a25, A26& _a26, A27& _a27, A28& _a28, A29& _a29, A30& _a30) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22), a23(_a23), a24(_a24), a25(_a25), a26(_a26), a27(_a27), a28(_a28), a29(_a29), a30(_a30) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(31);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+		keys.pack_key(pk, 23); pk.pack(a23);
+		keys.pack_key(pk, 24); pk.pack(a24);
+		keys.pack_key(pk, 25); pk.pack(a25);
+		keys.pack_key(pk, 26); pk.pack(a26);
+		keys.pack_key(pk, 27); pk.pack(a27);
+		keys.pack_key(pk, 28); pk.pack(a28);
+		keys.pack_key(pk, 29); pk.pack(a29);
+		keys.pack_key(pk, 30); pk.pack(a30);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			case 23: p->val.convert(&a23); break;
+			case 24: p->val.convert(&a24); break;
+			case 25: p->val.convert(&a25); break;
+			case 26: p->val.convert(&a26); break;
+			case 27: p->val.convert(&a27); break;
+			case 28: p->val.convert(&a28); break;
+			case 29: p->val.convert(&a29); break;
+			case 30: p->val.convert(&a30); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*31);
+		o->via.map.size = 31;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+		o->via.map.ptr[23].key = keys.key(23);
+		o->via.map.ptr[23].val = object(a23, z);
+		o->via.map.ptr[24].key = keys.key(24);
+		o->via.map.ptr[24].val = object(a24, z);
+		o->via.map.ptr[25].key = keys.key(25);
+		o->via.map.ptr[25].val = object(a25, z);
+		o->via.map.ptr[26].key = keys.key(26);
+		o->via.map.ptr[26].val = object(a26, z);
+		o->via.map.ptr[27].key = keys.key(27);
+		o->via.map.ptr[27].val = object(a27, z);
+		o->via.map.ptr[28].key = keys.key(28);
+		o->via.map.ptr[28].val = object(a28, z);
+		o->via.map.ptr[29].key = keys.key(29);
+		o->via.map.ptr[29].val = object(a29, z);
+		o->via.map.ptr[30].key = keys.key(30);
+		o->via.map.ptr[30].val = object(a30, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+	A23& a23;
+	A24& a24;
+	A25& a25;
+	A26& a26;
+	A27& a27;
+	A28& a28;
+	A29& a29;
+	A30& a30;
+};
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27, typename A28, typename A29, typename A30, typename A31>
+struct define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29, A30, A31> {
+	define_map(const define_map_keys& _keys, A0& _a0, A1& _a1, A2& _a2, A3& _a3, A4& _a4, A5& _a5, A6& _a6, A7& _a7, A8& _a8, A9& _a9, A10& _a10, A11& _a11, A12& _a12, A13& _a13, A14& _a14, A15& _a15, A16& _a16, A17& _a17, A18& _a18, A19& _a19, A20& _a20, A21& _a21, A22& _a22, A23& _a23, A24& _a24, A25& _a25, A26& _a26, A27& _a27, A28& _a28, A29& _a29, A30& _a30, A31& _a31) :
+		keys(_keys), a0(_a0), a1(_a1), a2(_a2), a3(_a3), a4(_a4), a5(_a5), a6(_a6), a7(_a7), a8(_a8), a9(_a9), a10(_a10), a11(_a11), a12(_a12), a13(_a13), a14(_a14), a15(_a15), a16(_a16), a17(_a17), a18(_a18), a19(_a19), a20(_a20), a21(_a21), a22(_a22), a23(_a23), a24(_a24), a25(_a25), a26(_a26), a27(_a27), a28(_a28), a29(_a29), a30(_a30), a31(_a31) {}
+	template <typename Packer>
+	void msgpack_pack(Packer& pk) const
+	{
+		pk.pack_map(32);
+		
+		keys.pack_key(pk, 0); pk.pack(a0);
+		keys.pack_key(pk, 1); pk.pack(a1);
+		keys.pack_key(pk, 2); pk.pack(a2);
+		keys.pack_key(pk, 3); pk.pack(a3);
+		keys.pack_key(pk, 4); pk.pack(a4);
+		keys.pack_key(pk, 5); pk.pack(a5);
+		keys.pack_key(pk, 6); pk.pack(a6);
+		keys.pack_key(pk, 7); pk.pack(a7);
+		keys.pack_key(pk, 8); pk.pack(a8);
+		keys.pack_key(pk, 9); pk.pack(a9);
+		keys.pack_key(pk, 10); pk.pack(a10);
+		keys.pack_key(pk, 11); pk.pack(a11);
+		keys.pack_key(pk, 12); pk.pack(a12);
+		keys.pack_key(pk, 13); pk.pack(a13);
+		keys.pack_key(pk, 14); pk.pack(a14);
+		keys.pack_key(pk, 15); pk.pack(a15);
+		keys.pack_key(pk, 16); pk.pack(a16);
+		keys.pack_key(pk, 17); pk.pack(a17);
+		keys.pack_key(pk, 18); pk.pack(a18);
+		keys.pack_key(pk, 19); pk.pack(a19);
+		keys.pack_key(pk, 20); pk.pack(a20);
+		keys.pack_key(pk, 21); pk.pack(a21);
+		keys.pack_key(pk, 22); pk.pack(a22);
+		keys.pack_key(pk, 23); pk.pack(a23);
+		keys.pack_key(pk, 24); pk.pack(a24);
+		keys.pack_key(pk, 25); pk.pack(a25);
+		keys.pack_key(pk, 26); pk.pack(a26);
+		keys.pack_key(pk, 27); pk.pack(a27);
+		keys.pack_key(pk, 28); pk.pack(a28);
+		keys.pack_key(pk, 29); pk.pack(a29);
+		keys.pack_key(pk, 30); pk.pack(a30);
+		keys.pack_key(pk, 31); pk.pack(a31);
+	}
+	void msgpack_unpack(msgpack::object o)
+	{
+		if(o.type != type::MAP) { throw type_error(); }
+		
+		for(object_kv* p(o.via.map.ptr), * const pend(o.via.map.ptr + o.via.map.size);
+				p < pend; ++p) {
+			switch(keys.find(p->key)) {
+			case 0: p->val.convert(&a0); break;
+			case 1: p->val.convert(&a1); break;
+			case 2: p->val.convert(&a2); break;
+			case 3: p->val.convert(&a3); break;
+			case 4: p->val.convert(&a4); break;
+			case 5: p->val.convert(&a5); break;
+			case 6: p->val.convert(&a6); break;
+			case 7: p->val.convert(&a7); break;
+			case 8: p->val.convert(&a8); break;
+			case 9: p->val.convert(&a9); break;
+			case 10: p->val.convert(&a10); break;
+			case 11: p->val.convert(&a11); break;
+			case 12: p->val.convert(&a12); break;
+			case 13: p->val.convert(&a13); break;
+			case 14: p->val.convert(&a14); break;
+			case 15: p->val.convert(&a15); break;
+			case 16: p->val.convert(&a16); break;
+			case 17: p->val.convert(&a17); break;
+			case 18: p->val.convert(&a18); break;
+			case 19: p->val.convert(&a19); break;
+			case 20: p->val.convert(&a20); break;
+			case 21: p->val.convert(&a21); break;
+			case 22: p->val.convert(&a22); break;
+			case 23: p->val.convert(&a23); break;
+			case 24: p->val.convert(&a24); break;
+			case 25: p->val.convert(&a25); break;
+			case 26: p->val.convert(&a26); break;
+			case 27: p->val.convert(&a27); break;
+			case 28: p->val.convert(&a28); break;
+			case 29: p->val.convert(&a29); break;
+			case 30: p->val.convert(&a30); break;
+			case 31: p->val.convert(&a31); break;
+			default: break;
+			}
+		}
+	}
+	void msgpack_object(msgpack::object* o, msgpack::zone* z) const
+	{
+		o->type = type::MAP;
+		o->via.map.ptr = (object_kv*)z->malloc(sizeof(object_kv)*32);
+		o->via.map.size = 32;
+		
+		o->via.map.ptr[0].key = keys.key(0);
+		o->via.map.ptr[0].val = object(a0, z);
+		o->via.map.ptr[1].key = keys.key(1);
+		o->via.map.ptr[1].val = object(a1, z);
+		o->via.map.ptr[2].key = keys.key(2);
+		o->via.map.ptr[2].val = object(a2, z);
+		o->via.map.ptr[3].key = keys.key(3);
+		o->via.map.ptr[3].val = object(a3, z);
+		o->via.map.ptr[4].key = keys.key(4);
+		o->via.map.ptr[4].val = object(a4, z);
+		o->via.map.ptr[5].key = keys.key(5);
+		o->via.map.ptr[5].val = object(a5, z);
+		o->via.map.ptr[6].key = keys.key(6);
+		o->via.map.ptr[6].val = object(a6, z);
+		o->via.map.ptr[7].key = keys.key(7);
+		o->via.map.ptr[7].val = object(a7, z);
+		o->via.map.ptr[8].key = keys.key(8);
+		o->via.map.ptr[8].val = object(a8, z);
+		o->via.map.ptr[9].key = keys.key(9);
+		o->via.map.ptr[9].val = object(a9, z);
+		o->via.map.ptr[10].key = keys.key(10);
+		o->via.map.ptr[10].val = object(a10, z);
+		o->via.map.ptr[11].key = keys.key(11);
+		o->via.map.ptr[11].val = object(a11, z);
+		o->via.map.ptr[12].key = keys.key(12);
+		o->via.map.ptr[12].val = object(a12, z);
+		o->via.map.ptr[13].key = keys.key(13);
+		o->via.map.ptr[13].val = object(a13, z);
+		o->via.map.ptr[14].key = keys.key(14);
+		o->via.map.ptr[14].val = object(a14, z);
+		o->via.map.ptr[15].key = keys.key(15);
+		o->via.map.ptr[15].val = object(a15, z);
+		o->via.map.ptr[16].key = keys.key(16);
+		o->via.map.ptr[16].val = object(a16, z);
+		o->via.map.ptr[17].key = keys.key(17);
+		o->via.map.ptr[17].val = object(a17, z);
+		o->via.map.ptr[18].key = keys.key(18);
+		o->via.map.ptr[18].val = object(a18, z);
+		o->via.map.ptr[19].key = keys.key(19);
+		o->via.map.ptr[19].val = object(a19, z);
+		o->via.map.ptr[20].key = keys.key(20);
+		o->via.map.ptr[20].val = object(a20, z);
+		o->via.map.ptr[21].key = keys.key(21);
+		o->via.map.ptr[21].val = object(a21, z);
+		o->via.map.ptr[22].key = keys.key(22);
+		o->via.map.ptr[22].val = object(a22, z);
+		o->via.map.ptr[23].key = keys.key(23);
+		o->via.map.ptr[23].val = object(a23, z);
+		o->via.map.ptr[24].key = keys.key(24);
+		o->via.map.ptr[24].val = object(a24, z);
+		o->via.map.ptr[25].key = keys.key(25);
+		o->via.map.ptr[25].val = object(a25, z);
+		o->via.map.ptr[26].key = keys.key(26);
+		o->via.map.ptr[26].val = object(a26, z);
+		o->via.map.ptr[27].key = keys.key(27);
+		o->via.map.ptr[27].val = object(a27, z);
+		o->via.map.ptr[28].key = keys.key(28);
+		o->via.map.ptr[28].val = object(a28, z);
+		o->via.map.ptr[29].key = keys.key(29);
+		o->via.map.ptr[29].val = object(a29, z);
+		o->via.map.ptr[30].key = keys.key(30);
+		o->via.map.ptr[30].val = object(a30, z);
+		o->via.map.ptr[31].key = keys.key(31);
+		o->via.map.ptr[31].val = object(a31, z);
+	}
+	
+	const define_map_keys& keys;
+	A0& a0;
+	A1& a1;
+	A2& a2;
+	A3& a3;
+	A4& a4;
+	A5& a5;
+	A6& a6;
+	A7& a7;
+	A8& a8;
+	A9& a9;
+	A10& a10;
+	A11& a11;
+	A12& a12;
+	A13& a13;
+	A14& a14;
+	A15& a15;
+	A16& a16;
+	A17& a17;
+	A18& a18;
+	A19& a19;
+	A20& a20;
+	A21& a21;
+	A22& a22;
+	A23& a23;
+	A24& a24;
+	A25& a25;
+	A26& a26;
+	A27& a27;
+	A28& a28;
+	A29& a29;
+	A30& a30;
+	A31& a31;
+};
+
+
+template <typename A0>
+define_map<A0> make_define_map(const define_map_keys& keys, A0& a0)
+{
+	return define_map<A0>(keys, a0);
+}
+
+template <typename A0, typename A1>
+define_map<A0, A1> make_define_map(const define_map_keys& keys, A0& a0, A1& a1)
+{
+	return define_map<A0, A1>(keys, a0, a1);
+}
+
+template <typename A0, typename A1, typename A2>
+define_map<A0, A1, A2> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2)
+{
+	return define_map<A0, A1, A2>(keys, a0, a1, a2);
+}
+
+template <typename A0, typename A1, typename A2, typename A3>
+define_map<A0, A1, A2, A3> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3)
+{
+	return define_map<A0, A1, A2, A3>(keys, a0, a1, a2, a3);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4>
+define_map<A0, A1, A2, A3, A4> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4)
+{
+	return define_map<A0, A1, A2, A3, A4>(keys, a0, a1, a2, a3, a4);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5>
+define_map<A0, A1, A2, A3, A4, A5> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5)
+{
+	return define_map<A0, A1, A2, A3, A4, A5>(keys, a0, a1, a2, a3, a4, a5);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+define_map<A0, A1, A2, A3, A4, A5, A6> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6>(keys, a0, a1, a2, a3, a4, a5, a6);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7>(keys, a0, a1, a2, a3, a4, a5, a6, a7);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22, A23& a23)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22, A23& a23, A24& a24)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22, A23& a23, A24& a24, A25& a25)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22, A23& a23, A24& a24, A25& a25, A26& a26)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22, A23& a23, A24& a24, A25& a25, A26& a26, A27& a27)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27, typename A28>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22, A23& a23, A24& a24, A25& a25, A26& a26, A27& a27, A28& a28)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27, typename A28, typename A29>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22, A23& a23, A24& a24, A25& a25, A26& a26, A27& a27, A28& a28, A29& a29)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27, typename A28, typename A29, typename A30>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29, A30> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22, A23& a23, A24& a24, A25& a25, A26& a26, A27& a27, A28& a28, A29& a29, A30& a30)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29, A30>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30);
+}
+
+template <typename A0, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6, typename A7, typename A8, typename A9, typename A10, typename A11, typename A12, typename A13, typename A14, typename A15, typename A16, typename A17, typename A18, typename A19, typename A20, typename A21, typename A22, typename A23, typename A24, typename A25, typename A26, typename A27, typename A28, typename A29, typename A30, typename A31>
+define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29, A30, A31> make_define_map(const define_map_keys& keys, A0& a0, A1& a1, A2& a2, A3& a3, A4& a4, A5& a5, A6& a6, A7& a7, A8& a8, A9& a9, A10& a10, A11& a11, A12& a12, A13& a13, A14& a14, A15& a15, A16& a16, A17& a17, A18& a18, A19& a19, A20& a20, A21& a21, A22& a22, A23& a23, A24& a24, A25& a25, A26& a26, A27& a27, A28& a28, A29& a29, A30& a30, A31& a31)
+{
+	return define_map<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24, A25, A26, A27, A28, A29, A30, A31>(keys, a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31);
+}
+
+
+}  // namespace type
+}  // namespace msgpack
+
+
+#endif /* msgpack/type/define_map.hpp */
+
@@ -27,9 +27,20 @@ namespace msgpack {
 // FIXME check overflow, underflow
 
 
+namespace type {
+
+template <> struct max_packed_size<float>
+	{ enum { value = 5 }; };
+
+template <> struct max_packed_size<double>
+	{ enum { value = 9 }; };
+
+}  // namespace type
+
+
 inline float& operator>> (object o, float& v)
 {
-	if(o.type != type::DOUBLE) { throw type_error(); }
+	if(o.type != type::DOUBLE && o.type != type::FLOAT) { throw type_error(); }
 	v = o.via.dec;
 	return v;
 }
@@ -44,7 +55,7 @@ inline packer<Stream>& operator<< (packer<Stream>& o, const float& v)
 
 inline double& operator>> (object o, double& v)
 {
-	if(o.type != type::DOUBLE) { throw type_error(); }
+	if(o.type != type::DOUBLE && o.type != type::FLOAT) { throw type_error(); }
 	v = o.via.dec;
 	return v;
 }
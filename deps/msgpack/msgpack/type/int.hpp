@@ -67,6 +67,42 @@ namespace detail {
 }  // namespace type
 
 
+namespace type {
+
+template <> struct max_packed_size<signed char>
+	{ enum { value = 1 + sizeof(signed char) }; };
+
+template <> struct max_packed_size<signed short>
+	{ enum { value = 1 + sizeof(signed short) }; };
+
+template <> struct max_packed_size<signed int>
+	{ enum { value = 1 + sizeof(signed int) }; };
+
+template <> struct max_packed_size<signed long>
+	{ enum { value = 1 + sizeof(signed long) }; };
+
+template <> struct max_packed_size<signed long long>
+	{ enum { value = 1 + sizeof(signed long long) }; };
+
+
+template <> struct max_packed_size<unsigned char>
+	{ enum { value = 1 + sizeof(unsigned char) }; };
+
+template <> struct max_packed_size<unsigned short>
+	{ enum { value = 1 + sizeof(unsigned short) }; };
+
+template <> struct max_packed_size<unsigned int>
+	{ enum { value = 1 + sizeof(unsigned int) }; };
+
+template <> struct max_packed_size<unsigned long>
+	{ enum { value = 1 + sizeof(unsigned long) }; };
+
+template <> struct max_packed_size<unsigned long long>
+	{ enum { value = 1 + sizeof(unsigned long long) }; };
+
+}  // namespace type
+
+
 inline signed char& operator>> (object o, signed char& v)
 	{ v = type::detail::convert_integer<signed char>(o); return v; }
 
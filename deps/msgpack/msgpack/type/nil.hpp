@@ -26,6 +26,9 @@ namespace type {
 
 struct nil { };
 
+template <> struct max_packed_size<nil>
+	{ enum { value = 1 }; };
+
 }  // namespace type
 
 
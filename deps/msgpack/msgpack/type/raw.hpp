@@ -63,16 +63,28 @@ struct raw_ref {
 
 inline type::raw_ref& operator>> (object o, type::raw_ref& v)
 {
-	if(o.type != type::RAW) { throw type_error(); }
-	v.ptr  = o.via.raw.ptr;
-	v.size = o.via.raw.size;
-	return v;
+	switch(o.type) {
+	case type::RAW:
+		v.ptr  = o.via.raw.ptr;
+		v.size = o.via.raw.size;
+		return v;
+	case type::BIN:
+		v.ptr  = o.via.bin.ptr;
+		v.size = o.via.bin.size;
+		return v;
+	default:
+		throw type_error();
+	}
 }
 
 template <typename Stream>
 inline packer<Stream>& operator<< (packer<Stream>& o, const type::raw_ref& v)
 {
-	o.pack_raw(v.size);
+	if(o.compat()) {
+		o.pack_raw(v.size);
+	} else {
+		o.pack_str(v.size);
+	}
 	o.pack_raw_body(v.ptr, v.size);
 	return o;
 }
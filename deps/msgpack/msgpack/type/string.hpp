@@ -26,15 +26,26 @@ namespace msgpack {
 
 inline std::string& operator>> (object o, std::string& v)
 {
-	if(o.type != type::RAW) { throw type_error(); }
-	v.assign(o.via.raw.ptr, o.via.raw.size);
-	return v;
+	switch(o.type) {
+	case type::RAW:
+		v.assign(o.via.raw.ptr, o.via.raw.size);
+		return v;
+	case type::BIN:
+		v.assign(o.via.bin.ptr, o.via.bin.size);
+		return v;
+	default:
+		throw type_error();
+	}
 }
 
 template <typename Stream>
 inline packer<Stream>& operator<< (packer<Stream>& o, const std::string& v)
 {
-	o.pack_raw(v.size());
+	if(o.compat()) {
+		o.pack_raw(v.size());
+	} else {
+		o.pack_str(v.size());
+	}
 	o.pack_raw_body(v.data(), v.size());
 	return o;
 }
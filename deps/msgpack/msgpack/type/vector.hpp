@@ -24,6 +24,41 @@
 namespace msgpack {
 
 
+namespace type {
+namespace detail {
+	// Elements of bounded size are packed with unchecked stores into
+	// batched writes (see packer::pack_fixed_range).
+	template <typename T, size_t N = max_packed_size<T>::value>
+	struct pack_vector {
+		template <typename Stream>
+		static void pack(packer<Stream>& o, const std::vector<T>& v)
+		{
+			if(!v.empty()) {
+				o.template pack_fixed_range<N>(&v[0], &v[0] + v.size());
+			}
+		}
+	};
+
+	template <typename T>
+	struct pack_vector<T, 0> {
+		template <typename Stream>
+		static void pack(packer<Stream>& o, const std::vector<T>& v)
+		{
+			for(typename std::vector<T>::const_iterator it(v.begin()), it_end(v.end());
+					it != it_end; ++it) {
+				o.pack(*it);
+			}
+		}
+	};
+
+	// std::vector<bool> is not contiguous
+	template <>
+	struct pack_vector<bool> : pack_vector<bool, 0> { };
+
+}  // namespace detail
+}  // namespace type
+
+
 template <typename T>
 inline std::vector<T>& operator>> (object o, std::vector<T>& v)
 {
@@ -46,10 +81,7 @@ template <typename Stream, typename T>
 inline packer<Stream>& operator<< (packer<Stream>& o, const std::vector<T>& v)
 {
 	o.pack_array(v.size());
-	for(typename std::vector<T>::const_iterator it(v.begin()), it_end(v.end());
-			it != it_end; ++it) {
-		o.pack(*it);
-	}
+	type::detail::pack_vector<T>::pack(o, v);
 	return o;
 }
 
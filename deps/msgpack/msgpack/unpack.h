@@ -26,6 +26,22 @@ extern "C" {
 #endif
 
 
+/**
+ * Limits on what an untrusted message may claim. A message that exceeds
+ * one of them fails to parse as soon as the offending header is read.
+ */
+typedef struct msgpack_unpack_limit {
+	size_t depth;   /* nesting of arrays and maps; 32 at most */
+	size_t array;   /* elements of an array */
+	size_t map;     /* key-value pairs of a map */
+	size_t raw;     /* bytes of a raw */
+	size_t total;   /* bytes of decoded objects and raws in a message */
+} msgpack_unpack_limit;
+
+/* no limits but the maximum depth */
+void msgpack_unpack_limit_init(msgpack_unpack_limit* limit);
+
+
 typedef struct msgpack_unpacker {
 	char* buffer;
 	size_t used;
@@ -35,6 +51,12 @@ typedef struct msgpack_unpacker {
 	msgpack_zone* z;
 	size_t initial_buffer_size;
 	void* ctx;
+	/* caller-owned region parsed in place (see msgpack_unpacker_feed_region) */
+	const char* region;
+	size_t region_size;
+	size_t region_off;
+	void* region_ref;
+	bool region_referenced;
 } msgpack_unpacker;
 
 
@@ -49,6 +71,22 @@ static inline char*  msgpack_unpacker_buffer(msgpack_unpacker* mpac);
 static inline size_t msgpack_unpacker_buffer_capacity(const msgpack_unpacker* mpac);
 static inline void   msgpack_unpacker_buffer_consumed(msgpack_unpacker* mpac, size_t size);
 
+/* applies from the next message on */
+void msgpack_unpacker_set_limit(msgpack_unpacker* mpac, const msgpack_unpack_limit* limit);
+
+/**
+ * Parses `size' bytes at `data' in place instead of copying them into the
+ * buffer. Raw objects point into the region, so it has to stay valid
+ * until release(release_data) is called, which happens once neither the
+ * unpacker nor any zone released from it refers to the region anymore.
+ * Only a header or raw that straddles two regions is copied, into the
+ * buffer; the rest of the message is parsed in place.
+ * Unparsed bytes of the previous region are moved to the buffer first.
+ */
+bool msgpack_unpacker_feed_region(msgpack_unpacker* mpac,
+		const char* data, size_t size,
+		void (*release)(void* data), void* release_data);
+
 
 int msgpack_unpacker_execute(msgpack_unpacker* mpac);
 
@@ -75,6 +113,11 @@ msgpack_unpack_return
 msgpack_unpack(const char* data, size_t len, size_t* off,
 		msgpack_zone* z, msgpack_object* result);
 
+msgpack_unpack_return
+msgpack_unpack_limited(const char* data, size_t len, size_t* off,
+		msgpack_zone* z, msgpack_object* result,
+		const msgpack_unpack_limit* limit);
+
 
 static inline size_t msgpack_unpacker_parsed_size(const msgpack_unpacker* mpac);
 
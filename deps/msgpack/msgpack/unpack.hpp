@@ -21,8 +21,12 @@
 #include "msgpack/unpack.h"
 #include "msgpack/object.hpp"
 #include "msgpack/zone.hpp"
+#include "msgpack/sysdep.h"
 #include <memory>
 #include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 #ifndef MSGPACK_UNPACKER_DEFAULT_INITIAL_BUFFER_SIZE
 #define MSGPACK_UNPACKER_DEFAULT_INITIAL_BUFFER_SIZE (32*1024)
@@ -37,6 +41,25 @@ struct unpack_error : public std::runtime_error {
 };
 
 
+// Limits on what an untrusted message may claim. Only the nesting depth
+// is limited by default.
+//
+// msgpack::unpack_limit limit;
+// limit.max_array(10000).max_raw(64*1024).max_total(1024*1024);
+// pac.set_limit(limit);
+//
+struct unpack_limit : public msgpack_unpack_limit {
+	unpack_limit()
+		{ msgpack_unpack_limit_init(this); }
+
+	unpack_limit& max_depth(size_t n) { depth = n; return *this; }
+	unpack_limit& max_array(size_t n) { array = n; return *this; }
+	unpack_limit& max_map(size_t n) { map = n; return *this; }
+	unpack_limit& max_raw(size_t n) { raw = n; return *this; }
+	unpack_limit& max_total(size_t n) { total = n; return *this; }
+};
+
+
 class unpacked {
 public:
 	unpacked() { }
@@ -56,12 +79,82 @@ public:
 	const std::auto_ptr<msgpack::zone>& zone() const
 		{ return m_zone; }
 
+#if __cplusplus >= 201103L
+	// auto_ptr transfers the zone on copy; these let an unpacked be
+	// returned by value and kept in standard containers.
+	unpacked(unpacked& o) :
+		m_obj(o.m_obj), m_zone(o.m_zone) { }
+
+	unpacked(unpacked&& o) :
+		m_obj(o.m_obj), m_zone(o.m_zone) { }
+
+	unpacked& operator=(unpacked& o)
+		{ m_obj = o.m_obj; m_zone = o.m_zone; return *this; }
+
+	unpacked& operator=(unpacked&& o)
+		{ m_obj = o.m_obj; m_zone = o.m_zone; return *this; }
+#endif
+
 private:
 	object m_obj;
 	std::auto_ptr<msgpack::zone> m_zone;
 };
 
 
+// Like unpacked, but the zone comes from a zone_pool and goes back to it
+// when the result is reset or destroyed.
+class pooled_unpacked {
+public:
+	pooled_unpacked(zone_pool* pool = NULL) :
+		m_zone(NULL), m_pool(pool) { }
+
+	~pooled_unpacked()
+		{ reset(); }
+
+	object& get()
+		{ return m_obj; }
+
+	const object& get() const
+		{ return m_obj; }
+
+	msgpack::zone* zone() const
+		{ return m_zone; }
+
+	zone_pool* pool() const
+		{ return m_pool; }
+
+	/*! a pool must be set before the result is passed to next() */
+	void set_pool(zone_pool* pool)
+		{ reset(); m_pool = pool; }
+
+	/*! return the zone to the pool */
+	void reset();
+
+	void swap(pooled_unpacked& o);
+
+#if __cplusplus >= 201103L
+	pooled_unpacked(pooled_unpacked&& o) :
+		m_obj(o.m_obj), m_zone(o.m_zone), m_pool(o.m_pool)
+		{ o.m_zone = NULL; }
+
+	pooled_unpacked& operator=(pooled_unpacked&& o)
+		{ pooled_unpacked(static_cast<pooled_unpacked&&>(o)).swap(*this); return *this; }
+#endif
+
+private:
+	object m_obj;
+	msgpack::zone* m_zone;
+	zone_pool* m_pool;
+
+	friend class unpacker;
+	friend class unpacked_queue;
+
+private:
+	pooled_unpacked(const pooled_unpacked&);
+	pooled_unpacked& operator=(const pooled_unpacked&);
+};
+
+
 class unpacker : public msgpack_unpacker {
 public:
 	unpacker(size_t init_buffer_size = MSGPACK_UNPACKER_DEFAULT_INITIAL_BUFFER_SIZE);
@@ -78,9 +171,24 @@ public:
 	/*! 3. specify the number of bytes actually copied */
 	void buffer_consumed(size_t size);
 
+	/*! 0. messages exceeding `limit' throw unpack_error */
+	void set_limit(const unpack_limit& limit);
+
+	/*! 1-3. or parse a caller-owned region in place */
+	// Raw objects point into the region, so it has to stay valid until
+	// release(release_data) is called. Only a header or raw that straddles
+	// two regions is copied.
+	void feed_region(const char* data, size_t size,
+			void (*release)(void* data) = NULL, void* release_data = NULL);
+
 	/*! 4. repeat next() until it retunrs false */
+	// A zone still held by `result' is cleared and reused for the next
+	// message instead of allocating a new one.
 	bool next(unpacked* result);
 
+	/*! 4. the same, but the zone is taken from result->pool() */
+	bool next(pooled_unpacked* result);
+
 	/*! 5. check if the size of message doesn't exceed assumption. */
 	size_t message_size() const;
 
@@ -111,6 +219,11 @@ public:
 	//         //// boost::shared_ptr is also usable:
 	//         // boost::shared_ptr<msgpack::zone> life(z.release());
 	//         // on_message(result.get(), life);
+	//
+	//         //// with a zone_pool, zones are recycled instead:
+	//         // msgpack::pooled_unpacked msg(&pool);
+	//         // pac.next(&msg);
+	//         // on_message(msg);  // msg.swap() it out to keep it
 	//     }
 	//
 	//     // 5.
@@ -155,6 +268,9 @@ public:
 private:
 	typedef msgpack_unpacker base;
 
+	/*! swap the zone of the parsed message with the empty `z' */
+	void swap_zone(zone& z);
+
 private:
 	unpacker(const unpacker&);
 };
@@ -163,6 +279,17 @@ private:
 static bool unpack(unpacked* result,
 		const char* data, size_t len, size_t* offset = NULL);
 
+static bool unpack(unpacked* result,
+		const char* data, size_t len, size_t* offset,
+		const unpack_limit& limit);
+
+// Decodes an array of numbers straight into `result' without building
+// msgpack::objects. Returns and throws unpack_error like unpack() above;
+// throws type_error if an element is not a number that converts to T.
+template <typename T>
+static bool unpack_array(std::vector<T>* result,
+		const char* data, size_t len, size_t* offset = NULL);
+
 
 // obsolete
 typedef enum {
@@ -216,6 +343,19 @@ inline void unpacker::buffer_consumed(size_t size)
 	return msgpack_unpacker_buffer_consumed(this, size);
 }
 
+inline void unpacker::set_limit(const unpack_limit& limit)
+{
+	msgpack_unpacker_set_limit(this, &limit);
+}
+
+inline void unpacker::feed_region(const char* data, size_t size,
+		void (*release)(void* data), void* release_data)
+{
+	if(!msgpack_unpacker_feed_region(this, data, size, release, release_data)) {
+		throw std::bad_alloc();
+	}
+}
+
 inline bool unpacker::next(unpacked* result)
 {
 	int ret = msgpack_unpacker_execute(this);
@@ -225,18 +365,50 @@ inline bool unpacker::next(unpacked* result)
 	}
 
 	if(ret == 0) {
-		result->zone().reset();
+		if(result->zone().get() != NULL) {
+			result->zone()->clear();
+		}
 		result->get() = object();
 		return false;
 
 	} else {
-		result->zone().reset( release_zone() );
+		if(result->zone().get() != NULL) {
+			result->zone()->clear();
+			swap_zone(*result->zone());
+		} else {
+			result->zone().reset( release_zone() );
+		}
 		result->get() = data();
 		reset();
 		return true;
 	}
 }
 
+inline bool unpacker::next(pooled_unpacked* result)
+{
+	int ret = msgpack_unpacker_execute(this);
+
+	if(ret < 0) {
+		throw unpack_error("parse error");
+	}
+
+	if(ret == 0) {
+		result->reset();
+		return false;
+
+	} else {
+		if(result->m_zone != NULL) {
+			result->m_zone->clear();
+		} else {
+			result->m_zone = result->m_pool->acquire();
+		}
+		swap_zone(*result->m_zone);
+		result->m_obj = data();
+		reset();
+		return true;
+	}
+}
+
 
 inline bool unpacker::execute()
 {
@@ -270,6 +442,17 @@ inline zone* unpacker::release_zone()
 	return r;
 }
 
+inline void unpacker::swap_zone(zone& z)
+{
+	if(!msgpack_unpacker_flush_zone(this)) {
+		throw std::bad_alloc();
+	}
+
+	msgpack_zone old = *base::z;
+	*base::z = z;
+	*static_cast<msgpack_zone*>(&z) = old;
+}
+
 inline void unpacker::reset_zone()
 {
 	msgpack_unpacker_reset_zone(this);
@@ -312,15 +495,35 @@ inline void unpacker::remove_nonparsed_buffer()
 }
 
 
+namespace detail {
+	inline bool unpack(unpacked* result,
+			const char* data, size_t len, size_t* offset,
+			const msgpack_unpack_limit* limit);
+}  // namespace detail
+
 inline bool unpack(unpacked* result,
 		const char* data, size_t len, size_t* offset)
+{
+	return detail::unpack(result, data, len, offset, NULL);
+}
+
+inline bool unpack(unpacked* result,
+		const char* data, size_t len, size_t* offset,
+		const unpack_limit& limit)
+{
+	return detail::unpack(result, data, len, offset, &limit);
+}
+
+inline bool detail::unpack(unpacked* result,
+		const char* data, size_t len, size_t* offset,
+		const msgpack_unpack_limit* limit)
 {
 	msgpack::object obj;
 	std::auto_ptr<msgpack::zone> z(new zone());
 
-	unpack_return ret = (unpack_return)msgpack_unpack(
+	unpack_return ret = (unpack_return)msgpack_unpack_limited(
 			data, len, offset, z.get(),
-			reinterpret_cast<msgpack_object*>(&obj));
+			reinterpret_cast<msgpack_object*>(&obj), limit);
 
 	switch(ret) {
 	case UNPACK_SUCCESS:
@@ -343,6 +546,184 @@ inline bool unpack(unpacked* result,
 }
 
 
+namespace detail {
+	// Each decode() returns the size of the element at p, or 0 if it is
+	// truncated.
+	template <typename T, bool Integer = std::numeric_limits<T>::is_integer>
+	struct unpack_number;
+
+	template <typename T>
+	struct unpack_number<T, true> {
+		static size_t decode(const unsigned char* p, size_t len, T* v)
+		{
+			uint64_t u;
+			int64_t i;
+			size_t n;
+			const unsigned char c = *p;
+			if(c <= 0x7f) {
+				*v = (T)c;  // positive fixnum fits in every T but bool
+				return 1;
+			} else if(c >= 0xe0) {
+				i = (signed char)c;
+				n = 1;
+				goto negative;
+			}
+
+			switch(c) {
+			case 0xcc:  // uint 8
+				if(len < 2) { return 0; }
+				u = p[1];
+				n = 2;
+				break;
+			case 0xcd:  // uint 16
+				if(len < 3) { return 0; }
+				u = _msgpack_load16(uint16_t, (p+1));
+				n = 3;
+				break;
+			case 0xce:  // uint 32
+				if(len < 5) { return 0; }
+				u = _msgpack_load32(uint32_t, (p+1));
+				n = 5;
+				break;
+			case 0xcf:  // uint 64
+				if(len < 9) { return 0; }
+				u = _msgpack_load64(uint64_t, (p+1));
+				n = 9;
+				break;
+			case 0xd0:  // int 8
+				if(len < 2) { return 0; }
+				i = (signed char)p[1];
+				n = 2;
+				goto signed_int;
+			case 0xd1:  // int 16
+				if(len < 3) { return 0; }
+				i = _msgpack_load16(int16_t, (p+1));
+				n = 3;
+				goto signed_int;
+			case 0xd2:  // int 32
+				if(len < 5) { return 0; }
+				i = _msgpack_load32(int32_t, (p+1));
+				n = 5;
+				goto signed_int;
+			case 0xd3:  // int 64
+				if(len < 9) { return 0; }
+				i = _msgpack_load64(int64_t, (p+1));
+				n = 9;
+				goto signed_int;
+			default:
+				throw type_error();
+			}
+
+			if(u > (uint64_t)std::numeric_limits<T>::max()) { throw type_error(); }
+			*v = (T)u;
+			return n;
+
+		signed_int:
+			if(i >= 0) {
+				if((uint64_t)i > (uint64_t)std::numeric_limits<T>::max()) { throw type_error(); }
+				*v = (T)i;
+				return n;
+			}
+		negative:
+			if(!std::numeric_limits<T>::is_signed ||
+					i < (int64_t)std::numeric_limits<T>::min()) { throw type_error(); }
+			*v = (T)i;
+			return n;
+		}
+	};
+
+	template <typename T>
+	struct unpack_number<T, false> {
+		static size_t decode(const unsigned char* p, size_t len, T* v)
+		{
+			union { uint32_t i; float f; } mem32;
+			union { uint64_t i; double f; } mem64;
+			switch(*p) {
+			case 0xca:  // float
+				if(len < 5) { return 0; }
+				mem32.i = _msgpack_load32(uint32_t, (p+1));
+				*v = (T)mem32.f;
+				return 5;
+			case 0xcb:  // double
+				if(len < 9) { return 0; }
+				mem64.i = _msgpack_load64(uint64_t, (p+1));
+				*v = (T)mem64.f;
+				return 9;
+			default:
+				throw type_error();
+			}
+		}
+	};
+}  // namespace detail
+
+template <typename T>
+inline bool unpack_array(std::vector<T>* result,
+		const char* data, size_t len, size_t* offset)
+{
+	size_t noff = 0;
+	if(offset != NULL) { noff = *offset; }
+	if(len <= noff) {
+		throw unpack_error("insufficient bytes");
+	}
+
+	const unsigned char* p = (const unsigned char*)data + noff;
+	const unsigned char* const pend = (const unsigned char*)data + len;
+
+	size_t n;
+	if((*p & 0xf0) == 0x90) {  // fix array
+		n = *p & 0x0f;
+		p += 1;
+	} else if(*p == 0xdc) {  // array 16
+		if(pend - p < 3) { throw unpack_error("insufficient bytes"); }
+		n = _msgpack_load16(uint16_t, (p+1));
+		p += 3;
+	} else if(*p == 0xdd) {  // array 32
+		if(pend - p < 5) { throw unpack_error("insufficient bytes"); }
+		n = _msgpack_load32(uint32_t, (p+1));
+		p += 5;
+	} else {
+		throw type_error();
+	}
+
+	// every element takes at least one byte; check it before sizing
+	// the vector so that a bogus length can't allocate
+	if((size_t)(pend - p) < n) {
+		throw unpack_error("insufficient bytes");
+	}
+
+	result->resize(n);
+	for(T* it = n ? &(*result)[0] : NULL, * const it_end = it + n;
+			it < it_end; ++it) {
+		size_t s = detail::unpack_number<T>::decode(p, pend - p, it);
+		if(s == 0) {
+			throw unpack_error("insufficient bytes");
+		}
+		p += s;
+	}
+
+	noff = (const char*)p - data;
+	if(offset != NULL) { *offset = noff; }
+	return noff < len;
+}
+
+
+inline void pooled_unpacked::reset()
+{
+	if(m_zone != NULL) {
+		m_pool->release(m_zone);
+		m_zone = NULL;
+	}
+	m_obj = object();
+}
+
+inline void pooled_unpacked::swap(pooled_unpacked& o)
+{
+	std::swap(m_obj, o.m_obj);
+	std::swap(m_zone, o.m_zone);
+	std::swap(m_pool, o.m_pool);
+}
+
+
 // obsolete
 inline unpack_return unpack(const char* data, size_t len, size_t* off,
 		zone* z, object* result)
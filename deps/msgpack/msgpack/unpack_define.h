@@ -41,13 +41,13 @@ typedef enum {
 	//CS_                = 0x02,  // false
 	//CS_                = 0x03,  // true
 
-	//CS_                = 0x04,
-	//CS_                = 0x05,
-	//CS_                = 0x06,
-	//CS_                = 0x07,
+	CS_BIN_8             = 0x04,
+	CS_BIN_16            = 0x05,
+	CS_BIN_32            = 0x06,
+	CS_EXT_8             = 0x07,
 
-	//CS_                = 0x08,
-	//CS_                = 0x09,
+	CS_EXT_16            = 0x08,
+	CS_EXT_32            = 0x09,
 	CS_FLOAT             = 0x0a,
 	CS_DOUBLE            = 0x0b,
 	CS_UINT_8            = 0x0c,
@@ -64,7 +64,7 @@ typedef enum {
 	//CS_BIG_INT_16        = 0x16,
 	//CS_BIG_INT_32        = 0x17,
 	//CS_BIG_FLOAT_16      = 0x18,
-	//CS_BIG_FLOAT_32      = 0x19,
+	CS_STR_8             = 0x19,
 	CS_RAW_16            = 0x1a,
 	CS_RAW_32            = 0x1b,
 	CS_ARRAY_16          = 0x1c,
@@ -75,6 +75,8 @@ typedef enum {
 	//ACS_BIG_INT_VALUE,
 	//ACS_BIG_FLOAT_VALUE,
 	ACS_RAW_VALUE,
+	ACS_BIN_VALUE,
+	ACS_EXT_VALUE,
 } msgpack_unpack_state;
 
 
@@ -85,6 +87,77 @@ typedef enum {
 } msgpack_container_type;
 
 
+/* how each header byte is decoded, for the table-driven header decoder */
+typedef enum {
+	HK_FAILED,
+	HK_POSITIVE_FIXNUM,
+	HK_NEGATIVE_FIXNUM,
+	HK_NIL,
+	HK_FALSE,
+	HK_TRUE,
+	HK_FIX_RAW,
+	HK_FIX_ARRAY,
+	HK_FIX_MAP,
+	HK_FLOAT,
+	HK_DOUBLE,
+	HK_UINT_8,
+	HK_UINT_16,
+	HK_UINT_32,
+	HK_UINT_64,
+	HK_INT_8,
+	HK_INT_16,
+	HK_INT_32,
+	HK_INT_64,
+	HK_RAW_16,
+	HK_RAW_32,
+	HK_ARRAY_16,
+	HK_ARRAY_32,
+	HK_MAP_16,
+	HK_MAP_32,
+	HK_STR_8,
+	HK_BIN_8,
+	HK_BIN_16,
+	HK_BIN_32,
+	HK_EXT_8,
+	HK_EXT_16,
+	HK_EXT_32,
+	HK_FIXEXT_1,
+	HK_FIXEXT_2,
+	HK_FIXEXT_4,
+	HK_FIXEXT_8,
+	HK_FIXEXT_16,
+} msgpack_header_kind;
+
+#define HK_16(k) k, k, k, k, k, k, k, k, k, k, k, k, k, k, k, k
+
+static const unsigned char msgpack_header_table[256] = {
+	/* 0x00 - 0x7f  Positive Fixnum */
+	HK_16(HK_POSITIVE_FIXNUM), HK_16(HK_POSITIVE_FIXNUM),
+	HK_16(HK_POSITIVE_FIXNUM), HK_16(HK_POSITIVE_FIXNUM),
+	HK_16(HK_POSITIVE_FIXNUM), HK_16(HK_POSITIVE_FIXNUM),
+	HK_16(HK_POSITIVE_FIXNUM), HK_16(HK_POSITIVE_FIXNUM),
+	/* 0x80 - 0x8f  FixMap */
+	HK_16(HK_FIX_MAP),
+	/* 0x90 - 0x9f  FixArray */
+	HK_16(HK_FIX_ARRAY),
+	/* 0xa0 - 0xbf  FixRaw */
+	HK_16(HK_FIX_RAW), HK_16(HK_FIX_RAW),
+	/* 0xc0 - 0xdf  Variable */
+	HK_NIL, HK_FAILED, HK_FALSE, HK_TRUE,
+	HK_BIN_8, HK_BIN_16, HK_BIN_32, HK_EXT_8,
+	HK_EXT_16, HK_EXT_32, HK_FLOAT, HK_DOUBLE,
+	HK_UINT_8, HK_UINT_16, HK_UINT_32, HK_UINT_64,
+	HK_INT_8, HK_INT_16, HK_INT_32, HK_INT_64,
+	HK_FIXEXT_1, HK_FIXEXT_2, HK_FIXEXT_4, HK_FIXEXT_8,
+	HK_FIXEXT_16, HK_STR_8, HK_RAW_16, HK_RAW_32,
+	HK_ARRAY_16, HK_ARRAY_32, HK_MAP_16, HK_MAP_32,
+	/* 0xe0 - 0xff  Negative Fixnum */
+	HK_16(HK_NEGATIVE_FIXNUM), HK_16(HK_NEGATIVE_FIXNUM),
+};
+
+#undef HK_16
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -40,12 +40,32 @@
 #error msgpack_unpack_user type is not defined
 #endif
 
+#ifndef msgpack_unpack_max_depth
+#define msgpack_unpack_max_depth(user) MSGPACK_EMBED_STACK_SIZE
+#endif
+
 #ifndef USE_CASE_RANGE
 #if !defined(_MSC_VER)
 #define USE_CASE_RANGE
 #endif
 #endif
 
+/* Header bytes are classified through msgpack_header_table unless
+ * MSGPACK_UNPACK_NO_HEADER_TABLE is defined, which builds the switch over
+ * byte ranges instead. GCC dispatches on the class with computed goto
+ * unless MSGPACK_UNPACK_NO_COMPUTED_GOTO is defined. */
+#ifndef USE_HEADER_TABLE
+#if !defined(MSGPACK_UNPACK_NO_HEADER_TABLE)
+#define USE_HEADER_TABLE
+#endif
+#endif
+
+#ifndef USE_COMPUTED_GOTO
+#if defined(USE_HEADER_TABLE) && defined(__GNUC__) && !defined(MSGPACK_UNPACK_NO_COMPUTED_GOTO)
+#define USE_COMPUTED_GOTO
+#endif
+#endif
+
 msgpack_unpack_struct_decl(_stack) {
 	msgpack_unpack_object obj;
 	size_t count;
@@ -131,14 +151,40 @@ msgpack_unpack_func(int, _execute)(msgpack_unpack_struct(_context)* ctx, const c
 	trail = trail_len; \
 	cs = _cs; \
 	goto _fixed_trail_again
+#define start_raw(raw_len) \
+	trail = raw_len; \
+	if(msgpack_unpack_callback(_raw_header)(user, trail) < 0) { goto _failed; } \
+	if(trail == 0) { goto _raw_zero; } \
+	cs = ACS_RAW_VALUE; \
+	goto _fixed_trail_again
+#define start_bin(bin_len) \
+	trail = bin_len; \
+	if(msgpack_unpack_callback(_raw_header)(user, trail) < 0) { goto _failed; } \
+	if(trail == 0) { goto _bin_zero; } \
+	cs = ACS_BIN_VALUE; \
+	goto _fixed_trail_again
+/* the type byte is read with the data */
+#define start_ext(ext_len) \
+	trail = ext_len; \
+	if(msgpack_unpack_callback(_raw_header)(user, trail) < 0) { goto _failed; } \
+	if(++trail == 0) { goto _failed; } \
+	cs = ACS_EXT_VALUE; \
+	goto _fixed_trail_again
 #define again_fixed_trail_if_zero(_cs, trail_len, ifzero) \
 	trail = trail_len; \
 	if(trail == 0) { goto ifzero; } \
 	cs = _cs; \
 	goto _fixed_trail_again
 
+// decode a fixed-size value right after its header when it's all there
+#define fast_fixed_trail(_cs, trail_len) \
+	if((size_t)(pe - p) <= trail_len) { again_fixed_trail(_cs, trail_len); } \
+	n = ++p; \
+	p += trail_len - 1
+
 #define start_container(func, count_, ct_) \
 	if(top >= MSGPACK_EMBED_STACK_SIZE) { goto _failed; } /* FIXME */ \
+	if(top >= msgpack_unpack_max_depth(user)) { goto _failed; } \
 	if(msgpack_unpack_callback(func)(user, count_, &stack[top].obj) < 0) { goto _failed; } \
 	if((count_) == 0) { obj = stack[top].obj; goto _push; } \
 	stack[top].ct = ct_; \
@@ -180,12 +226,166 @@ msgpack_unpack_func(int, _execute)(msgpack_unpack_struct(_context)* ctx, const c
 #define SWITCH_RANGE(FROM, TO) } else if(FROM <= *p && *p <= TO) {
 #define SWITCH_RANGE_DEFAULT   } else {
 #define SWITCH_RANGE_END       } }
+#endif
+
+#ifdef USE_COMPUTED_GOTO
+	static const void* const header_labels[] = {
+		&&_hk_failed,
+		&&_hk_positive_fixnum,
+		&&_hk_negative_fixnum,
+		&&_hk_nil,
+		&&_hk_false,
+		&&_hk_true,
+		&&_hk_fix_raw,
+		&&_hk_fix_array,
+		&&_hk_fix_map,
+		&&_hk_float,
+		&&_hk_double,
+		&&_hk_uint_8,
+		&&_hk_uint_16,
+		&&_hk_uint_32,
+		&&_hk_uint_64,
+		&&_hk_int_8,
+		&&_hk_int_16,
+		&&_hk_int_32,
+		&&_hk_int_64,
+		&&_hk_raw_16,
+		&&_hk_raw_32,
+		&&_hk_array_16,
+		&&_hk_array_32,
+		&&_hk_map_16,
+		&&_hk_map_32,
+		&&_hk_str_8,
+		&&_hk_bin_8,
+		&&_hk_bin_16,
+		&&_hk_bin_32,
+		&&_hk_ext_8,
+		&&_hk_ext_16,
+		&&_hk_ext_32,
+		&&_hk_fixext_1,
+		&&_hk_fixext_2,
+		&&_hk_fixext_4,
+		&&_hk_fixext_8,
+		&&_hk_fixext_16,
+	};
+#define HEADER_SWITCH_BEGIN    goto *header_labels[msgpack_header_table[*p]]; {
+#define HEADER_CASE(l, kind)   l:
+#define HEADER_SWITCH_END      }
+#else
+#define HEADER_SWITCH_BEGIN    switch(msgpack_header_table[*p]) {
+#define HEADER_CASE(l, kind)   case kind:
+#define HEADER_SWITCH_END      }
 #endif
 
 	if(p == pe) { goto _out; }
 	do {
 		switch(cs) {
 		case CS_HEADER:
+#ifdef USE_HEADER_TABLE
+			HEADER_SWITCH_BEGIN
+			HEADER_CASE(_hk_positive_fixnum, HK_POSITIVE_FIXNUM)
+				push_fixed_value(_uint8, *(uint8_t*)p);
+			HEADER_CASE(_hk_negative_fixnum, HK_NEGATIVE_FIXNUM)
+				push_fixed_value(_int8, *(int8_t*)p);
+			HEADER_CASE(_hk_fix_raw, HK_FIX_RAW)
+				start_raw(((unsigned int)*p & 0x1f));
+			HEADER_CASE(_hk_fix_array, HK_FIX_ARRAY)
+				start_container(_array, ((unsigned int)*p) & 0x0f, CT_ARRAY_ITEM);
+			HEADER_CASE(_hk_fix_map, HK_FIX_MAP)
+				start_container(_map, ((unsigned int)*p) & 0x0f, CT_MAP_KEY);
+			HEADER_CASE(_hk_nil, HK_NIL)
+				push_simple_value(_nil);
+			HEADER_CASE(_hk_false, HK_FALSE)
+				push_simple_value(_false);
+			HEADER_CASE(_hk_true, HK_TRUE)
+				push_simple_value(_true);
+			HEADER_CASE(_hk_float, HK_FLOAT)
+				fast_fixed_trail(CS_FLOAT, 4); {
+					union { uint32_t i; float f; } mem;
+					mem.i = _msgpack_load32(uint32_t,n);
+					push_fixed_value(_float, mem.f); }
+			HEADER_CASE(_hk_double, HK_DOUBLE)
+				fast_fixed_trail(CS_DOUBLE, 8); {
+					union { uint64_t i; double f; } mem;
+					mem.i = _msgpack_load64(uint64_t,n);
+					push_fixed_value(_double, mem.f); }
+			HEADER_CASE(_hk_uint_8, HK_UINT_8)
+				fast_fixed_trail(CS_UINT_8, 1);
+				push_fixed_value(_uint8, *(uint8_t*)n);
+			HEADER_CASE(_hk_uint_16, HK_UINT_16)
+				fast_fixed_trail(CS_UINT_16, 2);
+				push_fixed_value(_uint16, _msgpack_load16(uint16_t,n));
+			HEADER_CASE(_hk_uint_32, HK_UINT_32)
+				fast_fixed_trail(CS_UINT_32, 4);
+				push_fixed_value(_uint32, _msgpack_load32(uint32_t,n));
+			HEADER_CASE(_hk_uint_64, HK_UINT_64)
+				fast_fixed_trail(CS_UINT_64, 8);
+				push_fixed_value(_uint64, _msgpack_load64(uint64_t,n));
+			HEADER_CASE(_hk_int_8, HK_INT_8)
+				fast_fixed_trail(CS_INT_8, 1);
+				push_fixed_value(_int8, *(int8_t*)n);
+			HEADER_CASE(_hk_int_16, HK_INT_16)
+				fast_fixed_trail(CS_INT_16, 2);
+				push_fixed_value(_int16, _msgpack_load16(int16_t,n));
+			HEADER_CASE(_hk_int_32, HK_INT_32)
+				fast_fixed_trail(CS_INT_32, 4);
+				push_fixed_value(_int32, _msgpack_load32(int32_t,n));
+			HEADER_CASE(_hk_int_64, HK_INT_64)
+				fast_fixed_trail(CS_INT_64, 8);
+				push_fixed_value(_int64, _msgpack_load64(int64_t,n));
+			HEADER_CASE(_hk_str_8, HK_STR_8)
+				fast_fixed_trail(CS_STR_8, 1);
+				start_raw(*(uint8_t*)n);
+			HEADER_CASE(_hk_raw_16, HK_RAW_16)
+				fast_fixed_trail(CS_RAW_16, 2);
+				start_raw(_msgpack_load16(uint16_t,n));
+			HEADER_CASE(_hk_raw_32, HK_RAW_32)
+				fast_fixed_trail(CS_RAW_32, 4);
+				start_raw(_msgpack_load32(uint32_t,n));
+			HEADER_CASE(_hk_bin_8, HK_BIN_8)
+				fast_fixed_trail(CS_BIN_8, 1);
+				start_bin(*(uint8_t*)n);
+			HEADER_CASE(_hk_bin_16, HK_BIN_16)
+				fast_fixed_trail(CS_BIN_16, 2);
+				start_bin(_msgpack_load16(uint16_t,n));
+			HEADER_CASE(_hk_bin_32, HK_BIN_32)
+				fast_fixed_trail(CS_BIN_32, 4);
+				start_bin(_msgpack_load32(uint32_t,n));
+			HEADER_CASE(_hk_ext_8, HK_EXT_8)
+				fast_fixed_trail(CS_EXT_8, 1);
+				start_ext(*(uint8_t*)n);
+			HEADER_CASE(_hk_ext_16, HK_EXT_16)
+				fast_fixed_trail(CS_EXT_16, 2);
+				start_ext(_msgpack_load16(uint16_t,n));
+			HEADER_CASE(_hk_ext_32, HK_EXT_32)
+				fast_fixed_trail(CS_EXT_32, 4);
+				start_ext(_msgpack_load32(uint32_t,n));
+			HEADER_CASE(_hk_fixext_1, HK_FIXEXT_1)
+				start_ext(1);
+			HEADER_CASE(_hk_fixext_2, HK_FIXEXT_2)
+				start_ext(2);
+			HEADER_CASE(_hk_fixext_4, HK_FIXEXT_4)
+				start_ext(4);
+			HEADER_CASE(_hk_fixext_8, HK_FIXEXT_8)
+				start_ext(8);
+			HEADER_CASE(_hk_fixext_16, HK_FIXEXT_16)
+				start_ext(16);
+			HEADER_CASE(_hk_array_16, HK_ARRAY_16)
+				fast_fixed_trail(CS_ARRAY_16, 2);
+				start_container(_array, _msgpack_load16(uint16_t,n), CT_ARRAY_ITEM);
+			HEADER_CASE(_hk_array_32, HK_ARRAY_32)
+				fast_fixed_trail(CS_ARRAY_32, 4);
+				start_container(_array, _msgpack_load32(uint32_t,n), CT_ARRAY_ITEM);
+			HEADER_CASE(_hk_map_16, HK_MAP_16)
+				fast_fixed_trail(CS_MAP_16, 2);
+				start_container(_map, _msgpack_load16(uint16_t,n), CT_MAP_KEY);
+			HEADER_CASE(_hk_map_32, HK_MAP_32)
+				fast_fixed_trail(CS_MAP_32, 4);
+				start_container(_map, _msgpack_load32(uint32_t,n), CT_MAP_KEY);
+			HEADER_CASE(_hk_failed, HK_FAILED)
+				goto _failed;
+			HEADER_SWITCH_END
+#else
 			SWITCH_RANGE_BEGIN
 			SWITCH_RANGE(0x00, 0x7f)  // Positive Fixnum
 				push_fixed_value(_uint8, *(uint8_t*)p);
@@ -201,12 +401,18 @@ msgpack_unpack_func(int, _execute)(msgpack_unpack_struct(_context)* ctx, const c
 					push_simple_value(_false);
 				case 0xc3:  // true
 					push_simple_value(_true);
-				//case 0xc4:
-				//case 0xc5:
-				//case 0xc6:
-				//case 0xc7:
-				//case 0xc8:
-				//case 0xc9:
+				case 0xc4:  // bin 8
+					again_fixed_trail(NEXT_CS(p), 1);
+				case 0xc5:  // bin 16
+					again_fixed_trail(NEXT_CS(p), 2);
+				case 0xc6:  // bin 32
+					again_fixed_trail(NEXT_CS(p), 4);
+				case 0xc7:  // ext 8
+					again_fixed_trail(NEXT_CS(p), 1);
+				case 0xc8:  // ext 16
+					again_fixed_trail(NEXT_CS(p), 2);
+				case 0xc9:  // ext 32
+					again_fixed_trail(NEXT_CS(p), 4);
 				case 0xca:  // float
 				case 0xcb:  // double
 				case 0xcc:  // unsigned int  8
@@ -218,12 +424,14 @@ msgpack_unpack_func(int, _execute)(msgpack_unpack_struct(_context)* ctx, const c
 				case 0xd2:  // signed int 32
 				case 0xd3:  // signed int 64
 					again_fixed_trail(NEXT_CS(p), 1 << (((unsigned int)*p) & 0x03));
-				//case 0xd4:
-				//case 0xd5:
-				//case 0xd6:  // big integer 16
-				//case 0xd7:  // big integer 32
-				//case 0xd8:  // big float 16
-				//case 0xd9:  // big float 32
+				case 0xd4:  // fixext 1
+				case 0xd5:  // fixext 2
+				case 0xd6:  // fixext 4
+				case 0xd7:  // fixext 8
+				case 0xd8:  // fixext 16
+					start_ext(1 << (((unsigned int)*p) - 0xd4));
+				case 0xd9:  // str 8
+					again_fixed_trail(NEXT_CS(p), 1);
 				case 0xda:  // raw 16
 				case 0xdb:  // raw 32
 				case 0xdc:  // array 16
@@ -235,7 +443,7 @@ msgpack_unpack_func(int, _execute)(msgpack_unpack_struct(_context)* ctx, const c
 					goto _failed;
 				}
 			SWITCH_RANGE(0xa0, 0xbf)  // FixRaw
-				again_fixed_trail_if_zero(ACS_RAW_VALUE, ((unsigned int)*p & 0x1f), _raw_zero);
+				start_raw(((unsigned int)*p & 0x1f));
 			SWITCH_RANGE(0x90, 0x9f)  // FixArray
 				start_container(_array, ((unsigned int)*p) & 0x0f, CT_ARRAY_ITEM);
 			SWITCH_RANGE(0x80, 0x8f)  // FixMap
@@ -244,6 +452,7 @@ msgpack_unpack_func(int, _execute)(msgpack_unpack_struct(_context)* ctx, const c
 			SWITCH_RANGE_DEFAULT
 				goto _failed;
 			SWITCH_RANGE_END
+#endif
 			// end CS_HEADER
 
 
@@ -302,24 +511,43 @@ msgpack_unpack_func(int, _execute)(msgpack_unpack_struct(_context)* ctx, const c
 			//	// FIXME
 			//	push_variable_value(_big_float, data, n, trail);
 
+			case CS_STR_8:
+				start_raw(*(uint8_t*)n);
 			case CS_RAW_16:
-				again_fixed_trail_if_zero(ACS_RAW_VALUE, _msgpack_load16(uint16_t,n), _raw_zero);
+				start_raw(_msgpack_load16(uint16_t,n));
 			case CS_RAW_32:
-				again_fixed_trail_if_zero(ACS_RAW_VALUE, _msgpack_load32(uint32_t,n), _raw_zero);
+				start_raw(_msgpack_load32(uint32_t,n));
 			case ACS_RAW_VALUE:
 			_raw_zero:
 				push_variable_value(_raw, data, n, trail);
 
+			case CS_BIN_8:
+				start_bin(*(uint8_t*)n);
+			case CS_BIN_16:
+				start_bin(_msgpack_load16(uint16_t,n));
+			case CS_BIN_32:
+				start_bin(_msgpack_load32(uint32_t,n));
+			case ACS_BIN_VALUE:
+			_bin_zero:
+				push_variable_value(_bin, data, n, trail);
+
+			case CS_EXT_8:
+				start_ext(*(uint8_t*)n);
+			case CS_EXT_16:
+				start_ext(_msgpack_load16(uint16_t,n));
+			case CS_EXT_32:
+				start_ext(_msgpack_load32(uint32_t,n));
+			case ACS_EXT_VALUE:
+				push_variable_value(_ext, data, n, trail);
+
 			case CS_ARRAY_16:
 				start_container(_array, _msgpack_load16(uint16_t,n), CT_ARRAY_ITEM);
 			case CS_ARRAY_32:
-				/* FIXME security guard */
 				start_container(_array, _msgpack_load32(uint32_t,n), CT_ARRAY_ITEM);
 
 			case CS_MAP_16:
 				start_container(_map, _msgpack_load16(uint16_t,n), CT_MAP_KEY);
 			case CS_MAP_32:
-				/* FIXME security guard */
 				start_container(_map, _msgpack_load32(uint32_t,n), CT_MAP_KEY);
 
 			default:
@@ -332,7 +560,7 @@ _push:
 	c = &stack[top-1];
 	switch(c->ct) {
 	case CT_ARRAY_ITEM:
-		if(msgpack_unpack_callback(_array_item)(user, &c->obj, obj) < 0) { goto _failed; }
+		if(msgpack_unpack_callback(_array_item)(user, c->count, &c->obj, obj) < 0) { goto _failed; }
 		if(--c->count == 0) {
 			obj = c->obj;
 			--top;
@@ -345,7 +573,7 @@ _push:
 		c->ct = CT_MAP_VALUE;
 		goto _header_again;
 	case CT_MAP_VALUE:
-		if(msgpack_unpack_callback(_map_item)(user, &c->obj, c->map_key, obj) < 0) { goto _failed; }
+		if(msgpack_unpack_callback(_map_item)(user, c->count, &c->obj, c->map_key, obj) < 0) { goto _failed; }
 		if(--c->count == 0) {
 			obj = c->obj;
 			--top;
@@ -362,6 +590,11 @@ _push:
 _header_again:
 		cs = CS_HEADER;
 		++p;
+#ifdef USE_COMPUTED_GOTO
+		// go straight to the next header instead of through switch(cs)
+		if(p != pe) { goto *header_labels[msgpack_header_table[*p]]; }
+		goto _out;
+#endif
 	} while(p != pe);
 	goto _out;
 
@@ -403,7 +636,15 @@ _end:
 #undef push_variable_value
 #undef again_fixed_trail
 #undef again_fixed_trail_if_zero
+#undef start_raw
+#undef start_bin
+#undef start_ext
+#undef fast_fixed_trail
 #undef start_container
 
 #undef NEXT_CS
+#undef msgpack_unpack_max_depth
+#undef HEADER_SWITCH_BEGIN
+#undef HEADER_CASE
+#undef HEADER_SWITCH_END
 
@@ -0,0 +1,396 @@
+//
+// MessagePack for C++ deserializing routine
+//
+// Copyright (C) 2008-2010 FURUHASHI Sadayuki
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+//
+#ifndef MSGPACK_UNPACKED_QUEUE_HPP__
+#define MSGPACK_UNPACKED_QUEUE_HPP__
+
+#include "msgpack/unpack.hpp"
+#include "msgpack/zone.hpp"
+#include "msgpack/sysdep.h"
+#include <algorithm>
+
+#ifndef MSGPACK_UNPACKED_QUEUE_DEFAULT_CAPACITY
+#define MSGPACK_UNPACKED_QUEUE_DEFAULT_CAPACITY 1024
+#endif
+
+namespace msgpack {
+
+
+namespace detail {
+	// Bounded lock-free ring (D. Vyukov's sequence-numbered cells). Any
+	// number of threads may push and pop; a batch claims consecutive
+	// cells with a single compare-and-swap.
+	template <typename T>
+	class bounded_queue {
+	public:
+		bounded_queue(size_t capacity);
+		~bounded_queue();
+
+	public:
+		/*! returns the number of elements pushed, which is less than
+		 *  `n' if the ring is full */
+		size_t push(const T* v, size_t n);
+
+		/*! returns the number of elements popped */
+		size_t pop(T* v, size_t n);
+
+	private:
+		struct cell {
+			volatile size_t seq;
+			T data;
+		};
+
+		cell* m_cells;
+		size_t m_mask;
+
+		// keep the positions on separate cache lines
+		char m_pad0[64];
+		volatile size_t m_push_pos;
+		char m_pad1[64];
+		volatile size_t m_pop_pos;
+		char m_pad2[64];
+
+	private:
+		bounded_queue(const bounded_queue&);
+	};
+}  // namespace detail
+
+
+class queued_unpacked;
+
+
+// Hands decoded messages from the threads that parse them over to the
+// threads that process them. The zones of processed messages flow back
+// through a second ring so that the parsing thread can put them into its
+// zone_pool again.
+//
+// // I/O thread
+// msgpack::pooled_unpacked msg(&pool);
+// while(pac.next(&msg)) {
+//     while(!queue.push(&msg)) { /* full */ }
+// }
+// queue.reclaim(&pool);
+//
+// // worker thread
+// msgpack::queued_unpacked msg;
+// while(queue.pop(&msg)) {
+//     on_message(msg.get());
+// }  // the zone goes back when msg is reset or destroyed
+//
+class unpacked_queue {
+public:
+	/*! `capacity' is rounded up to a power of 2 */
+	unpacked_queue(size_t capacity = MSGPACK_UNPACKED_QUEUE_DEFAULT_CAPACITY);
+	~unpacked_queue();
+
+public:
+	/*! move messages into the queue. returns how many of the first `n'
+	 *  were queued; the rest are left untouched because it is full */
+	size_t push(pooled_unpacked* msgs, size_t n = 1);
+
+	/*! take up to `n' messages out of the queue. returns how many */
+	size_t pop(queued_unpacked* results, size_t n = 1);
+
+	/*! put the zones of processed messages into `pool'. call it from
+	 *  the thread that owns the pool. returns the number of zones */
+	size_t reclaim(zone_pool* pool);
+
+	/*! give back the zone of a processed message */
+	void recycle(zone* z);
+
+private:
+	// plain struct so that batches on the stack cost no construction
+	struct entry {
+		msgpack_object obj;
+		zone* z;
+	};
+
+	enum { BATCH = 64 };
+
+	detail::bounded_queue<entry> m_queue;
+	detail::bounded_queue<zone*> m_free;
+
+private:
+	unpacked_queue(const unpacked_queue&);
+};
+
+
+// Message taken out of an unpacked_queue. Its zone goes back to the queue
+// when it is reset or destroyed, so the queue must outlive it.
+class queued_unpacked {
+public:
+	queued_unpacked() :
+		m_zone(NULL), m_queue(NULL) { }
+
+	~queued_unpacked()
+		{ reset(); }
+
+	object& get()
+		{ return m_obj; }
+
+	const object& get() const
+		{ return m_obj; }
+
+	msgpack::zone* zone() const
+		{ return m_zone; }
+
+	/*! give the zone back to the queue */
+	void reset();
+
+	void swap(queued_unpacked& o);
+
+#if __cplusplus >= 201103L
+	queued_unpacked(queued_unpacked&& o) :
+		m_obj(o.m_obj), m_zone(o.m_zone), m_queue(o.m_queue)
+		{ o.m_zone = NULL; }
+
+	queued_unpacked& operator=(queued_unpacked&& o)
+		{ queued_unpacked(static_cast<queued_unpacked&&>(o)).swap(*this); return *this; }
+#endif
+
+private:
+	object m_obj;
+	msgpack::zone* m_zone;
+	unpacked_queue* m_queue;
+
+	friend class unpacked_queue;
+
+private:
+	queued_unpacked(const queued_unpacked&);
+	queued_unpacked& operator=(const queued_unpacked&);
+};
+
+
+namespace detail {
+
+template <typename T>
+inline bounded_queue<T>::bounded_queue(size_t capacity)
+{
+	size_t size = 2;
+	while(size < capacity) {
+		size *= 2;
+	}
+
+	m_cells = new cell[size];
+	for(size_t i = 0; i < size; ++i) {
+		m_cells[i].seq = i;
+	}
+	m_mask = size - 1;
+	m_push_pos = 0;
+	m_pop_pos = 0;
+}
+
+template <typename T>
+inline bounded_queue<T>::~bounded_queue()
+{
+	delete[] m_cells;
+}
+
+template <typename T>
+inline size_t bounded_queue<T>::push(const T* v, size_t n)
+{
+	size_t pos = m_push_pos;
+	while(true) {
+		// count the free cells from pos; a cell is free for this lap
+		// when its sequence equals its position
+		size_t m = 0;
+		while(m < n && m <= m_mask) {
+			cell* c = &m_cells[(pos + m) & m_mask];
+			if(_msgpack_load_acquire(&c->seq) != pos + m) {
+				break;
+			}
+			++m;
+		}
+
+		if(m == 0) {
+			cell* c = &m_cells[pos & m_mask];
+			if((ptrdiff_t)(_msgpack_load_acquire(&c->seq) - pos) < 0) {
+				return 0;  // full
+			}
+			// another producer got ahead
+			pos = m_push_pos;
+			continue;
+		}
+
+		if(_msgpack_sync_bool_compare_and_swap(&m_push_pos, pos, pos + m)) {
+			for(size_t i = 0; i < m; ++i) {
+				cell* c = &m_cells[(pos + i) & m_mask];
+				c->data = v[i];
+				_msgpack_store_release(&c->seq, pos + i + 1);
+			}
+			return m;
+		}
+		pos = m_push_pos;
+	}
+}
+
+template <typename T>
+inline size_t bounded_queue<T>::pop(T* v, size_t n)
+{
+	size_t pos = m_pop_pos;
+	while(true) {
+		// a cell is filled when its sequence is one past its position
+		size_t m = 0;
+		while(m < n && m <= m_mask) {
+			cell* c = &m_cells[(pos + m) & m_mask];
+			if(_msgpack_load_acquire(&c->seq) != pos + m + 1) {
+				break;
+			}
+			++m;
+		}
+
+		if(m == 0) {
+			cell* c = &m_cells[pos & m_mask];
+			if((ptrdiff_t)(_msgpack_load_acquire(&c->seq) - (pos + 1)) < 0) {
+				return 0;  // empty
+			}
+			// another consumer got ahead
+			pos = m_pop_pos;
+			continue;
+		}
+
+		if(_msgpack_sync_bool_compare_and_swap(&m_pop_pos, pos, pos + m)) {
+			for(size_t i = 0; i < m; ++i) {
+				cell* c = &m_cells[(pos + i) & m_mask];
+				v[i] = c->data;
+				_msgpack_store_release(&c->seq, pos + i + m_mask + 1);
+			}
+			return m;
+		}
+		pos = m_pop_pos;
+	}
+}
+
+}  // namespace detail
+
+
+inline unpacked_queue::unpacked_queue(size_t capacity) :
+	m_queue(capacity), m_free(capacity) { }
+
+inline unpacked_queue::~unpacked_queue()
+{
+	entry e[BATCH];
+	size_t n;
+	while((n = m_queue.pop(e, BATCH)) > 0) {
+		for(size_t i = 0; i < n; ++i) {
+			delete e[i].z;
+		}
+	}
+
+	zone* z[BATCH];
+	while((n = m_free.pop(z, BATCH)) > 0) {
+		for(size_t i = 0; i < n; ++i) {
+			delete z[i];
+		}
+	}
+}
+
+inline size_t unpacked_queue::push(pooled_unpacked* msgs, size_t n)
+{
+	size_t done = 0;
+	while(done < n) {
+		entry e[BATCH];
+		const size_t count = std::min(n - done, (size_t)BATCH);
+		for(size_t i = 0; i < count; ++i) {
+			e[i].obj = msgs[done + i].m_obj;
+			e[i].z = msgs[done + i].m_zone;
+		}
+
+		const size_t pushed = m_queue.push(e, count);
+		for(size_t i = 0; i < pushed; ++i) {
+			// the zone now belongs to the queue
+			msgs[done + i].m_zone = NULL;
+			msgs[done + i].m_obj = object();
+		}
+		done += pushed;
+
+		if(pushed < count) {
+			break;
+		}
+	}
+	return done;
+}
+
+inline size_t unpacked_queue::pop(queued_unpacked* results, size_t n)
+{
+	size_t done = 0;
+	while(done < n) {
+		entry e[BATCH];
+		const size_t count = std::min(n - done, (size_t)BATCH);
+
+		const size_t popped = m_queue.pop(e, count);
+		for(size_t i = 0; i < popped; ++i) {
+			queued_unpacked& r = results[done + i];
+			r.reset();
+			r.m_obj = e[i].obj;
+			r.m_zone = e[i].z;
+			r.m_queue = this;
+		}
+		done += popped;
+
+		if(popped < count) {
+			break;
+		}
+	}
+	return done;
+}
+
+inline size_t unpacked_queue::reclaim(zone_pool* pool)
+{
+	size_t total = 0;
+	zone* z[BATCH];
+	size_t n;
+	while((n = m_free.pop(z, BATCH)) > 0) {
+		for(size_t i = 0; i < n; ++i) {
+			pool->release(z[i]);
+		}
+		total += n;
+	}
+	return total;
+}
+
+inline void unpacked_queue::recycle(zone* z)
+{
+	// clear it here to keep the work off the parsing thread
+	z->clear();
+	if(m_free.push(&z, 1) == 0) {
+		delete z;
+	}
+}
+
+
+inline void queued_unpacked::reset()
+{
+	if(m_zone != NULL) {
+		m_queue->recycle(m_zone);
+		m_zone = NULL;
+	}
+	m_obj = object();
+}
+
+inline void queued_unpacked::swap(queued_unpacked& o)
+{
+	std::swap(m_obj, o.m_obj);
+	std::swap(m_zone, o.m_zone);
+	std::swap(m_queue, o.m_queue);
+}
+
+
+}  // namespace msgpack
+
+#endif /* msgpack/unpacked_queue.hpp */
+
@@ -19,6 +19,7 @@
 #define MSGPACK_VREFBUFFER_HPP__
 
 #include "msgpack/vrefbuffer.h"
+#include "msgpack/pack.hpp"
 #include <stdexcept>
 
 namespace msgpack {
@@ -86,6 +87,18 @@ private:
 };
 
 
+namespace detail {
+	// write() keeps a reference to large buffers, but bounded values are
+	// packed on the stack
+	template <>
+	inline void fixed_writer<vrefbuffer>::append(vrefbuffer& s,
+			const char* buf, size_t len)
+	{
+		s.append_copy(buf, len);
+	}
+}  // namespace detail
+
+
 }  // namespace msgpack
 
 #endif /* msgpack/vrefbuffer.hpp */
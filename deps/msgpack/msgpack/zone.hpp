@@ -43,6 +43,9 @@ public:
 
 	void clear();
 
+	/*! exchange the contents with `o'. it never allocates */
+	void swap(zone& o);
+
 	
 	template <typename T>
 	T* allocate();
@@ -106,6 +109,35 @@ private:
 };
 
 
+// Keeps cleared zones for reuse so that a loop that parses a message into
+// a zone, hands it off and drops it later doesn't allocate a zone each
+// time. It is not thread-safe.
+class zone_pool {
+public:
+	zone_pool(size_t max_free = 16,
+			size_t chunk_size = MSGPACK_ZONE_CHUNK_SIZE);
+	~zone_pool();
+
+public:
+	/*! take an empty zone out of the pool, or allocate one */
+	zone* acquire();
+
+	/*! clear `z' and put it back. `z' is deleted if the pool is full */
+	void release(zone* z);
+
+	size_t free_size() const
+		{ return m_free.size(); }
+
+private:
+	std::vector<zone*> m_free;
+	size_t m_max_free;
+	size_t m_chunk_size;
+
+private:
+	zone_pool(const zone_pool&);
+};
+
+
 
 inline zone::zone(size_t chunk_size)
 {
@@ -156,6 +188,13 @@ inline void zone::clear()
 	msgpack_zone_clear(this);
 }
 
+inline void zone::swap(zone& o)
+{
+	msgpack_zone tmp = o;
+	static_cast<msgpack_zone&>(o) = *this;
+	static_cast<msgpack_zone&>(*this) = tmp;
+}
+
 template <typename T>
 void zone::object_destructor(void* obj)
 {
@@ -442,6 +481,42 @@ T* zone::allocate(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9,
 }
 
 
+inline zone_pool::zone_pool(size_t max_free, size_t chunk_size) :
+	m_max_free(max_free), m_chunk_size(chunk_size)
+{
+	// release() never has to grow the vector
+	m_free.reserve(max_free);
+}
+
+inline zone_pool::~zone_pool()
+{
+	for(std::vector<zone*>::iterator it(m_free.begin()), it_end(m_free.end());
+			it != it_end; ++it) {
+		delete *it;
+	}
+}
+
+inline zone* zone_pool::acquire()
+{
+	if(m_free.empty()) {
+		return new zone(m_chunk_size);
+	}
+	zone* z = m_free.back();
+	m_free.pop_back();
+	return z;
+}
+
+inline void zone_pool::release(zone* z)
+{
+	if(m_free.size() < m_max_free) {
+		z->clear();
+		m_free.push_back(z);
+	} else {
+		delete z;
+	}
+}
+
+
 }  // namespace msgpack
 
 #endif /* msgpack/zone.hpp */
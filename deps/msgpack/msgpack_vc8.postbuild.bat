@@ -10,6 +10,7 @@ copy msgpack\sysdep.h           include\msgpack\
 copy msgpack.h                     include\
 copy msgpack\sbuffer.h             include\msgpack\
 copy msgpack\vrefbuffer.h          include\msgpack\
+copy msgpack\crc32c.h              include\msgpack\
 copy msgpack\zbuffer.h             include\msgpack\
 copy msgpack\pack.h                include\msgpack\
 copy msgpack\unpack.h              include\msgpack\
@@ -21,6 +22,7 @@ copy msgpack\vrefbuffer.hpp        include\msgpack\
 copy msgpack\zbuffer.hpp           include\msgpack\
 copy msgpack\pack.hpp              include\msgpack\
 copy msgpack\unpack.hpp            include\msgpack\
+copy msgpack\unpacked_queue.hpp    include\msgpack\
 copy msgpack\object.hpp            include\msgpack\
 copy msgpack\zone.hpp              include\msgpack\
 copy msgpack\type.hpp              include\msgpack\type\
@@ -38,6 +40,7 @@ copy msgpack\type\string.hpp       include\msgpack\type\
 copy msgpack\type\vector.hpp       include\msgpack\type\
 copy msgpack\type\tuple.hpp        include\msgpack\type\
 copy msgpack\type\define.hpp       include\msgpack\type\
+copy msgpack\type\define_map.hpp   include\msgpack\type\
 copy msgpack\type\tr1\unordered_map.hpp  include\msgpack\type\
 copy msgpack\type\tr1\unordered_set.hpp  include\msgpack\type\
 
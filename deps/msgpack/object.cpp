@@ -40,6 +40,7 @@ std::ostream& operator<< (std::ostream& s, const object o)
 		break;
 
 	case type::DOUBLE:
+	case type::FLOAT:
 		s << o.via.dec;
 		break;
 
@@ -47,6 +48,14 @@ std::ostream& operator<< (std::ostream& s, const object o)
 		(s << '"').write(o.via.raw.ptr, o.via.raw.size) << '"';
 		break;
 
+	case type::BIN:
+		(s << "(bin)\"").write(o.via.bin.ptr, o.via.bin.size) << '"';
+		break;
+
+	case type::EXT:
+		(s << "(ext " << (int)o.via.ext.type << ")\"").write(o.via.ext.ptr, o.via.ext.size) << '"';
+		break;
+
 	case type::ARRAY:
 		s << "[";
 		if(o.via.array.size != 0) {
@@ -32,7 +32,7 @@
 #endif
 
 
-int msgpack_pack_object(msgpack_packer* pk, msgpack_object d)
+static int pack_object(msgpack_packer* pk, msgpack_object d, bool compat)
 {
 	switch(d.type) {
 	case MSGPACK_OBJECT_NIL:
@@ -54,13 +54,36 @@ int msgpack_pack_object(msgpack_packer* pk, msgpack_object d)
 	case MSGPACK_OBJECT_DOUBLE:
 		return msgpack_pack_double(pk, d.via.dec);
 
+	case MSGPACK_OBJECT_FLOAT:
+		return msgpack_pack_float(pk, (float)d.via.dec);
+
 	case MSGPACK_OBJECT_RAW:
 		{
-			int ret = msgpack_pack_raw(pk, d.via.raw.size);
+			int ret = compat ?
+				msgpack_pack_raw(pk, d.via.raw.size) :
+				msgpack_pack_str(pk, d.via.raw.size);
 			if(ret < 0) { return ret; }
 			return msgpack_pack_raw_body(pk, d.via.raw.ptr, d.via.raw.size);
 		}
 
+	case MSGPACK_OBJECT_BIN:
+		{
+			int ret = compat ?
+				msgpack_pack_raw(pk, d.via.bin.size) :
+				msgpack_pack_bin(pk, d.via.bin.size);
+			if(ret < 0) { return ret; }
+			return msgpack_pack_bin_body(pk, d.via.bin.ptr, d.via.bin.size);
+		}
+
+	case MSGPACK_OBJECT_EXT:
+		{
+			int ret;
+			if(compat) { return -1; }  /* no ext in the old spec */
+			ret = msgpack_pack_ext(pk, d.via.ext.size, d.via.ext.type);
+			if(ret < 0) { return ret; }
+			return msgpack_pack_ext_body(pk, d.via.ext.ptr, d.via.ext.size);
+		}
+
 	case MSGPACK_OBJECT_ARRAY:
 		{
 			int ret = msgpack_pack_array(pk, d.via.array.size);
@@ -69,7 +92,7 @@ int msgpack_pack_object(msgpack_packer* pk, msgpack_object d)
 			msgpack_object* o = d.via.array.ptr;
 			msgpack_object* const oend = d.via.array.ptr + d.via.array.size;
 			for(; o != oend; ++o) {
-				ret = msgpack_pack_object(pk, *o);
+				ret = pack_object(pk, *o, compat);
 				if(ret < 0) { return ret; }
 			}
 
@@ -84,9 +107,9 @@ int msgpack_pack_object(msgpack_packer* pk, msgpack_object d)
 			msgpack_object_kv* kv = d.via.map.ptr;
 			msgpack_object_kv* const kvend = d.via.map.ptr + d.via.map.size;
 			for(; kv != kvend; ++kv) {
-				ret = msgpack_pack_object(pk, kv->key);
+				ret = pack_object(pk, kv->key, compat);
 				if(ret < 0) { return ret; }
-				ret = msgpack_pack_object(pk, kv->val);
+				ret = pack_object(pk, kv->val, compat);
 				if(ret < 0) { return ret; }
 			}
 
@@ -98,6 +121,16 @@ int msgpack_pack_object(msgpack_packer* pk, msgpack_object d)
 	}
 }
 
+int msgpack_pack_object(msgpack_packer* pk, msgpack_object d)
+{
+	return pack_object(pk, d, false);
+}
+
+int msgpack_pack_object_compat(msgpack_packer* pk, msgpack_object d)
+{
+	return pack_object(pk, d, true);
+}
+
 
 void msgpack_object_print(FILE* out, msgpack_object o)
 {
@@ -119,6 +152,7 @@ void msgpack_object_print(FILE* out, msgpack_object o)
 		break;
 
 	case MSGPACK_OBJECT_DOUBLE:
+	case MSGPACK_OBJECT_FLOAT:
 		fprintf(out, "%f", o.via.dec);
 		break;
 
@@ -128,6 +162,18 @@ void msgpack_object_print(FILE* out, msgpack_object o)
 		fprintf(out, "\"");
 		break;
 
+	case MSGPACK_OBJECT_BIN:
+		fprintf(out, "(bin)\"");
+		fwrite(o.via.bin.ptr, o.via.bin.size, 1, out);
+		fprintf(out, "\"");
+		break;
+
+	case MSGPACK_OBJECT_EXT:
+		fprintf(out, "(ext %d)\"", o.via.ext.type);
+		fwrite(o.via.ext.ptr, o.via.ext.size, 1, out);
+		fprintf(out, "\"");
+		break;
+
 	case MSGPACK_OBJECT_ARRAY:
 		fprintf(out, "[");
 		if(o.via.array.size != 0) {
@@ -186,12 +232,22 @@ bool msgpack_object_equal(const msgpack_object x, const msgpack_object y)
 		return x.via.i64 == y.via.i64;
 
 	case MSGPACK_OBJECT_DOUBLE:
+	case MSGPACK_OBJECT_FLOAT:
 		return x.via.dec == y.via.dec;
 
 	case MSGPACK_OBJECT_RAW:
 		return x.via.raw.size == y.via.raw.size &&
 			memcmp(x.via.raw.ptr, y.via.raw.ptr, x.via.raw.size) == 0;
 
+	case MSGPACK_OBJECT_BIN:
+		return x.via.bin.size == y.via.bin.size &&
+			memcmp(x.via.bin.ptr, y.via.bin.ptr, x.via.bin.size) == 0;
+
+	case MSGPACK_OBJECT_EXT:
+		return x.via.ext.type == y.via.ext.type &&
+			x.via.ext.size == y.via.ext.size &&
+			memcmp(x.via.ext.ptr, y.via.ext.ptr, x.via.ext.size) == 0;
+
 	case MSGPACK_OBJECT_ARRAY:
 		if(x.via.array.size != y.via.array.size) {
 			return false;
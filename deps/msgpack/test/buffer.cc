@@ -48,3 +48,27 @@ TEST(buffer, zbuffer)
 	size_t size = zbuf.size();
 }
 
+
+
+TEST(buffer, crc32c)
+{
+	// check value of the Castagnoli polynomial
+	EXPECT_EQ(0xe3069283U, msgpack_crc32c(0, "123456789", 9));
+	EXPECT_EQ(0xe3069283U, msgpack_crc32c_sw(0, "123456789", 9));
+	EXPECT_EQ(0U, msgpack_crc32c(0, "", 0));
+
+	// every length and alignment, whole and in two pieces
+	char buf[256];
+	for(unsigned int i = 0; i < sizeof(buf); ++i) {
+		buf[i] = (char)(i * 7 + 3);
+	}
+	for(size_t off = 0; off < 8; ++off) {
+		for(size_t len = 0; off + len <= sizeof(buf); len += 5) {
+			uint32_t crc = msgpack_crc32c_sw(0, buf + off, len);
+			EXPECT_EQ(crc, msgpack_crc32c(0, buf + off, len));
+			EXPECT_EQ(crc, msgpack_crc32c(
+					msgpack_crc32c(0, buf + off, len / 3),
+					buf + off + len / 3, len - len / 3));
+		}
+	}
+}
@@ -72,3 +72,109 @@ TEST(convert, enum_member)
 	EXPECT_EQ(enum_member::B, to.flag);
 }
 
+
+
+class map_member {
+public:
+	map_member() : id(0), name("default"), score(0.0) { }
+
+	int id;
+	std::string name;
+	double score;
+
+	MSGPACK_DEFINE_MAP(id, name, score);
+};
+
+TEST(convert, define_map)
+{
+	map_member src;
+	src.id = 7;
+	src.name = "kumofs";
+	src.score = 1.5;
+
+	msgpack::sbuffer sbuf;
+	msgpack::pack(sbuf, src);
+
+	msgpack::zone z;
+	msgpack::object obj;
+	EXPECT_EQ(msgpack::UNPACK_SUCCESS,
+			msgpack::unpack(sbuf.data(), sbuf.size(), NULL, &z, &obj));
+	EXPECT_EQ(msgpack::type::MAP, obj.type);
+	EXPECT_EQ(3u, obj.via.map.size);
+
+	map_member to;
+	EXPECT_NO_THROW( obj.convert(&to) );
+	EXPECT_EQ(7, to.id);
+	EXPECT_EQ("kumofs", to.name);
+	EXPECT_EQ(1.5, to.score);
+
+	msgpack::object obj2(src, &z);
+	EXPECT_EQ(obj, obj2);
+}
+
+TEST(convert, define_map_compatibility)
+{
+	msgpack::sbuffer sbuf;
+	msgpack::packer<msgpack::sbuffer> pk(&sbuf);
+	pk.pack_map(3);
+	pk.pack(std::string("score"));   pk.pack(2.5);
+	pk.pack(std::string("unknown")); pk.pack(1);
+	pk.pack(std::string("id"));      pk.pack(3);
+
+	msgpack::zone z;
+	msgpack::object obj;
+	EXPECT_EQ(msgpack::UNPACK_SUCCESS,
+			msgpack::unpack(sbuf.data(), sbuf.size(), NULL, &z, &obj));
+
+	map_member to;
+	EXPECT_NO_THROW( obj.convert(&to) );
+	EXPECT_EQ(3, to.id);
+	EXPECT_EQ("default", to.name);
+	EXPECT_EQ(2.5, to.score);
+
+	std::vector<int> arr(1);
+	msgpack::object obj2(arr, &z);
+	EXPECT_THROW( obj2.convert(&to), msgpack::type_error );
+}
+
+TEST(convert, define_map_keys)
+{
+	msgpack::type::define_map_keys keys(" a, bb ,ccc,\td ");
+	EXPECT_EQ(4u, keys.size());
+	EXPECT_EQ(0, keys.find("a", 1));
+	EXPECT_EQ(1, keys.find("bb", 2));
+	EXPECT_EQ(2, keys.find("ccc", 3));
+	EXPECT_EQ(3, keys.find("d", 1));
+	EXPECT_EQ(-1, keys.find("b", 1));
+	EXPECT_EQ(-1, keys.find("cc", 2));
+	EXPECT_EQ(-1, keys.find("", 0));
+}
+
+TEST(convert, define_map_keys_duplicate)
+{
+	EXPECT_THROW( msgpack::type::define_map_keys keys("a, b, a"), std::invalid_argument );
+	EXPECT_THROW( msgpack::type::define_map_keys keys("x,x"), std::invalid_argument );
+}
+
+
+TEST(convert, bin_to_string)
+{
+	msgpack::sbuffer sbuf;
+	msgpack::packer<msgpack::sbuffer> pk(sbuf);
+	pk.pack_bin(3).pack_bin_body("a\0b", 3);
+
+	msgpack::zone z;
+	msgpack::object obj;
+	EXPECT_EQ(msgpack::UNPACK_SUCCESS,
+			msgpack::unpack(sbuf.data(), sbuf.size(), NULL, &z, &obj));
+	EXPECT_EQ(msgpack::type::BIN, obj.type);
+
+	std::string s;
+	EXPECT_NO_THROW( obj.convert(&s) );
+	EXPECT_EQ(std::string("a\0b", 3), s);
+
+	msgpack::type::raw_ref r;
+	EXPECT_NO_THROW( obj.convert(&r) );
+	EXPECT_EQ(3u, r.size);
+	EXPECT_EQ(0, memcmp("a\0b", r.ptr, 3));
+}
@@ -132,3 +132,24 @@ TEST(object, construct_primitive)
 	EXPECT_EQ(true, obj_bool.via.boolean);
 }
 
+
+
+TEST(object, pack_float)
+{
+	msgpack::object obj;
+	obj.type = msgpack::type::FLOAT;
+	obj.via.dec = 0.375;
+	EXPECT_EQ(0.375f, obj.as<float>());
+	EXPECT_EQ(0.375, obj.as<double>());
+
+	// 5 bytes instead of 9, and unpacks as a double
+	msgpack::sbuffer sbuf;
+	msgpack::pack(sbuf, obj);
+	EXPECT_EQ(5u, sbuf.size());
+	EXPECT_EQ(0xca, (unsigned char)sbuf.data()[0]);
+
+	msgpack::unpacked msg;
+	msgpack::unpack(&msg, sbuf.data(), sbuf.size());
+	EXPECT_EQ(msgpack::type::DOUBLE, msg.get().type);
+	EXPECT_EQ(0.375, msg.get().via.dec);
+}
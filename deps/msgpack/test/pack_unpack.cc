@@ -50,6 +50,138 @@ TEST(pack, myclass)
 }
 
 
+// The bytes of a vrefbuffer, which may refer to memory that must still
+// be alive
+static std::string vref_bytes(const msgpack::vrefbuffer& vbuf)
+{
+	std::string s;
+	const struct iovec* vec = vbuf.vector();
+	for(size_t i = 0; i < vbuf.vector_size(); ++i) {
+		s.append((const char*)vec[i].iov_base, vec[i].iov_len);
+	}
+	return s;
+}
+
+
+struct fixedclass {
+	fixedclass() : i8(0), u16(0), i32(0), u64(0), dec(0), flag(false) { }
+
+	signed char i8;
+	unsigned short u16;
+	int i32;
+	unsigned long long u64;
+	double dec;
+	bool flag;
+
+	MSGPACK_DEFINE(i8, u16, i32, u64, dec, flag);
+};
+
+TEST(pack, fixedclass)
+{
+	typedef msgpack::type::define<signed char, unsigned short, int,
+			unsigned long long, double, bool> fixed_define;
+	typedef msgpack::type::define<int, std::string> variable_define;
+	EXPECT_EQ(1 + 2 + 3 + 5 + 9 + 9 + 1,
+			(int)msgpack::type::max_packed_size<fixed_define>::value);
+	EXPECT_EQ(0, (int)msgpack::type::max_packed_size<variable_define>::value);
+
+	fixedclass m;
+	m.i8 = -100;
+	m.u16 = 65535;
+	m.i32 = -70000;
+	m.u64 = 0xffffffffffffffffULL;
+	m.dec = 1.5;
+	m.flag = true;
+
+	msgpack::sbuffer fast;
+	msgpack::pack(fast, m);
+
+	msgpack::sbuffer slow;
+	msgpack::packer<msgpack::sbuffer> pk(slow);
+	msgpack::type::make_define(m.i8, m.u16, m.i32, m.u64, m.dec, m.flag).msgpack_pack(pk);
+
+	ASSERT_EQ(slow.size(), fast.size());
+	EXPECT_EQ(0, memcmp(slow.data(), fast.data(), fast.size()));
+
+	// A vrefbuffer referring to everything it is given must still get a
+	// copy: the value is packed on the stack, and the next one packed
+	// there overwrites it
+	msgpack::vrefbuffer vref(1);
+	msgpack::pack(vref, m);
+	m.i8 = 100;
+	msgpack::pack(vref, m);
+	msgpack::pack(slow, m);
+	m.i8 = -100;
+
+	std::string vbytes = vref_bytes(vref);
+	ASSERT_EQ(slow.size(), vbytes.size());
+	EXPECT_EQ(0, memcmp(slow.data(), vbytes.data(), vbytes.size()));
+
+	msgpack::zone z;
+	msgpack::object obj;
+	EXPECT_EQ(msgpack::UNPACK_SUCCESS,
+			msgpack::unpack(fast.data(), fast.size(), NULL, &z, &obj));
+
+	fixedclass m2 = obj.as<fixedclass>();
+	EXPECT_EQ(m.i8, m2.i8);
+	EXPECT_EQ(m.u16, m2.u16);
+	EXPECT_EQ(m.i32, m2.i32);
+	EXPECT_EQ(m.u64, m2.u64);
+	EXPECT_EQ(m.dec, m2.dec);
+	EXPECT_EQ(m.flag, m2.flag);
+}
+
+
+TEST(pack, vector_arithmetic)
+{
+	// large enough to span several batches
+	std::vector<long long> iv;
+	std::vector<double> dv;
+	for(long long i = 0; i < 20000; ++i) {
+		iv.push_back((i % 2 ? -1 : 1) * i * i * i);
+		dv.push_back(i * 0.25);
+	}
+
+	msgpack::sbuffer fast;
+	msgpack::pack(fast, iv);
+	msgpack::pack(fast, dv);
+
+	std::ostringstream fast_os;
+	msgpack::pack(fast_os, iv);
+	msgpack::pack(fast_os, dv);
+
+	msgpack::sbuffer slow;
+	msgpack::packer<msgpack::sbuffer> pk(slow);
+	pk.pack_array(iv.size());
+	for(size_t i = 0; i < iv.size(); ++i) { pk.pack(iv[i]); }
+	pk.pack_array(dv.size());
+	for(size_t i = 0; i < dv.size(); ++i) { pk.pack(dv[i]); }
+
+	ASSERT_EQ(slow.size(), fast.size());
+	EXPECT_EQ(0, memcmp(slow.data(), fast.data(), fast.size()));
+	ASSERT_EQ(slow.size(), fast_os.str().size());
+	EXPECT_EQ(0, memcmp(slow.data(), fast_os.str().data(), slow.size()));
+
+	// whole batches are large enough for vrefbuffer to refer to them
+	msgpack::vrefbuffer vref;
+	msgpack::pack(vref, iv);
+	msgpack::pack(vref, dv);
+	std::string vbytes = vref_bytes(vref);
+	ASSERT_EQ(slow.size(), vbytes.size());
+	EXPECT_EQ(0, memcmp(slow.data(), vbytes.data(), slow.size()));
+
+	msgpack::zone z;
+	msgpack::object obj;
+	size_t off = 0;
+	EXPECT_EQ(msgpack::UNPACK_EXTRA_BYTES,
+			msgpack::unpack(fast.data(), fast.size(), &off, &z, &obj));
+	EXPECT_TRUE(iv == obj.as<std::vector<long long> >());
+	EXPECT_EQ(msgpack::UNPACK_SUCCESS,
+			msgpack::unpack(fast.data(), fast.size(), &off, &z, &obj));
+	EXPECT_TRUE(dv == obj.as<std::vector<double> >());
+}
+
+
 TEST(unpack, myclass)
 {
 	msgpack::sbuffer sbuf;
@@ -125,3 +257,330 @@ TEST(unpack, sequence_compat)
 	EXPECT_EQ(3, obj.as<int>());
 }
 
+
+TEST(unpack, array)
+{
+	std::vector<long long> src;
+	src.push_back(0);
+	src.push_back(127);
+	src.push_back(-32);
+	src.push_back(-33);
+	src.push_back(255);
+	src.push_back(-129);
+	src.push_back(65536);
+	src.push_back(-2147483648LL);
+	src.push_back(9223372036854775807LL);
+	for(int i = 0; i < 20; ++i) { src.push_back(i * 1000); }  // array 16
+
+	msgpack::sbuffer sbuf;
+	msgpack::pack(sbuf, src);
+	std::vector<float> fsrc;
+	fsrc.push_back(0.5f);
+	fsrc.push_back(-1.25f);
+	msgpack::pack(sbuf, fsrc);
+
+	std::vector<long long> v;
+	size_t off = 0;
+	EXPECT_TRUE(msgpack::unpack_array(&v, sbuf.data(), sbuf.size(), &off));
+	EXPECT_TRUE(src == v);
+
+	std::vector<double> d;
+	EXPECT_FALSE(msgpack::unpack_array(&d, sbuf.data(), sbuf.size(), &off));
+	EXPECT_EQ(sbuf.size(), off);
+	ASSERT_EQ(2u, d.size());
+	EXPECT_EQ(0.5, d[0]);
+	EXPECT_EQ(-1.25, d[1]);
+
+	// out of range, wrong element type, not an array
+	std::vector<int> narrow;
+	EXPECT_THROW(msgpack::unpack_array(&narrow, sbuf.data(), sbuf.size()),
+			msgpack::type_error);
+	EXPECT_THROW(msgpack::unpack_array(&d, sbuf.data(), sbuf.size()),
+			msgpack::type_error);
+	msgpack::sbuffer str;
+	msgpack::pack(str, std::string("abc"));
+	EXPECT_THROW(msgpack::unpack_array(&d, str.data(), str.size()),
+			msgpack::type_error);
+
+	// truncated element and bogus length
+	off = 0;
+	EXPECT_THROW(msgpack::unpack_array(&v, sbuf.data(), 20, &off),
+			msgpack::unpack_error);
+	EXPECT_EQ(0u, off);
+	const char huge[] = { (char)0xdd, (char)0xff, (char)0xff, (char)0xff, (char)0xff, 0x01 };
+	EXPECT_THROW(msgpack::unpack_array(&v, huge, sizeof(huge)),
+			msgpack::unpack_error);
+}
+
+
+TEST(unpack, large_container)
+{
+	// crosses several steps of the incremental preallocation
+	std::vector<int> v;
+	std::map<int, int> m;
+	for(int i = 0; i < 5000; ++i) {
+		v.push_back(i);
+		m[i] = -i;
+	}
+	msgpack::sbuffer sbuf;
+	msgpack::pack(sbuf, v);
+	msgpack::pack(sbuf, m);
+
+	msgpack::unpacked msg;
+	size_t off = 0;
+	msgpack::unpack(&msg, sbuf.data(), sbuf.size(), &off);
+	EXPECT_TRUE(v == msg.get().as<std::vector<int> >());
+	msgpack::unpack(&msg, sbuf.data(), sbuf.size(), &off);
+	EXPECT_TRUE(m == (msg.get().as<std::map<int, int> >()));
+
+	// a header claiming 4G elements doesn't allocate them up front
+	const char huge[] = { (char)0xdd, (char)0xff, (char)0xff, (char)0xff, (char)0xff, 0x01 };
+	msgpack::zone z;
+	msgpack::object obj;
+	EXPECT_EQ(msgpack::UNPACK_CONTINUE,
+			msgpack::unpack(huge, sizeof(huge), NULL, &z, &obj));
+}
+
+
+TEST(unpack, limit)
+{
+	std::vector<std::vector<int> > nested(3, std::vector<int>(10, 1));
+	msgpack::sbuffer sbuf;
+	msgpack::pack(sbuf, nested);
+
+	std::map<std::string, int> m;
+	m["abc"] = 1;
+	m["defgh"] = 2;
+	msgpack::sbuffer mbuf;
+	msgpack::pack(mbuf, m);
+
+	msgpack::unpacked msg;
+	msgpack::unpack(&msg, sbuf.data(), sbuf.size(), NULL,
+			msgpack::unpack_limit().max_depth(2).max_array(10));
+	EXPECT_TRUE(nested == msg.get().as<std::vector<std::vector<int> > >());
+	EXPECT_THROW(msgpack::unpack(&msg, sbuf.data(), sbuf.size(), NULL,
+			msgpack::unpack_limit().max_depth(1)), msgpack::unpack_error);
+	EXPECT_THROW(msgpack::unpack(&msg, sbuf.data(), sbuf.size(), NULL,
+			msgpack::unpack_limit().max_array(9)), msgpack::unpack_error);
+
+	msgpack::unpack(&msg, mbuf.data(), mbuf.size(), NULL,
+			msgpack::unpack_limit().max_map(2).max_raw(5));
+	EXPECT_TRUE(m == (msg.get().as<std::map<std::string, int> >()));
+	EXPECT_THROW(msgpack::unpack(&msg, mbuf.data(), mbuf.size(), NULL,
+			msgpack::unpack_limit().max_map(1)), msgpack::unpack_error);
+	EXPECT_THROW(msgpack::unpack(&msg, mbuf.data(), mbuf.size(), NULL,
+			msgpack::unpack_limit().max_raw(4)), msgpack::unpack_error);
+
+	// two pairs and eight bytes of raws
+	const size_t total = 2 * sizeof(msgpack::object_kv) + 8;
+	msgpack::unpack(&msg, mbuf.data(), mbuf.size(), NULL,
+			msgpack::unpack_limit().max_total(total));
+	EXPECT_THROW(msgpack::unpack(&msg, mbuf.data(), mbuf.size(), NULL,
+			msgpack::unpack_limit().max_total(total - 1)), msgpack::unpack_error);
+
+	// the unpacker checks every message; the raw fails on its header
+	msgpack::unpacker pac;
+	pac.set_limit(msgpack::unpack_limit().max_raw(4));
+	pac.reserve_buffer(mbuf.size());
+	memcpy(pac.buffer(), mbuf.data(), 7);
+	pac.buffer_consumed(7);
+	EXPECT_THROW(pac.next(&msg), msgpack::unpack_error);
+}
+
+
+TEST(pack, str_bin)
+{
+	const size_t lens[] = { 0, 31, 32, 255, 256, 65535, 65536 };
+	const unsigned char str_heads[] = { 0xa0, 0xbf, 0xd9, 0xd9, 0xda, 0xda, 0xdb };
+	const unsigned char bin_heads[] = { 0xc4, 0xc4, 0xc4, 0xc4, 0xc5, 0xc5, 0xc6 };
+	const unsigned char raw_heads[] = { 0xa0, 0xbf, 0xda, 0xda, 0xda, 0xda, 0xdb };
+
+	for(unsigned int i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i) {
+		std::string body(lens[i], 'x');
+		msgpack::sbuffer sbuf;
+		msgpack::packer<msgpack::sbuffer> pk(sbuf);
+		pk.pack_str(body.size());
+		pk.pack_str_body(body.data(), body.size());
+		pk.pack_bin(body.size());
+		pk.pack_bin_body(body.data(), body.size());
+
+		size_t off = 0;
+		msgpack::unpacked msg;
+		EXPECT_EQ(str_heads[i], (unsigned char)sbuf.data()[0]);
+		msgpack::unpack(&msg, sbuf.data(), sbuf.size(), &off);
+		EXPECT_EQ(msgpack::type::RAW, msg.get().type);
+		EXPECT_EQ(body, std::string(msg.get().via.raw.ptr, msg.get().via.raw.size));
+
+		EXPECT_EQ(bin_heads[i], (unsigned char)sbuf.data()[off]);
+		msgpack::unpack(&msg, sbuf.data(), sbuf.size(), &off);
+		EXPECT_EQ(msgpack::type::BIN, msg.get().type);
+		EXPECT_EQ(body, std::string(msg.get().via.bin.ptr, msg.get().via.bin.size));
+		EXPECT_EQ(sbuf.size(), off);
+
+		// str objects repack as str and bin as bin, and both as raw in
+		// compat mode
+		msgpack::sbuffer rbuf;
+		msgpack::sbuffer cbuf;
+		msgpack::packer<msgpack::sbuffer> cpk(cbuf);
+		cpk.set_compat(true);
+		off = 0;
+		msgpack::unpack(&msg, sbuf.data(), sbuf.size(), &off);
+		msgpack::pack(rbuf, msg.get());
+		cpk.pack(msg.get());
+		EXPECT_EQ(str_heads[i], (unsigned char)rbuf.data()[0]);
+		EXPECT_EQ(raw_heads[i], (unsigned char)cbuf.data()[0]);
+		size_t boff = off;
+		size_t cboff = cbuf.size();
+		msgpack::unpack(&msg, sbuf.data(), sbuf.size(), &off);
+		msgpack::pack(rbuf, msg.get());
+		cpk.pack(msg.get());
+		EXPECT_EQ(bin_heads[i], (unsigned char)rbuf.data()[rbuf.size() - (off - boff)]);
+		EXPECT_EQ(raw_heads[i], (unsigned char)cbuf.data()[cboff]);
+
+		// std::string likewise
+		msgpack::sbuffer strbuf;
+		msgpack::pack(strbuf, body);
+		EXPECT_EQ(str_heads[i], (unsigned char)strbuf.data()[0]);
+		msgpack::sbuffer strcbuf;
+		msgpack::packer<msgpack::sbuffer>(strcbuf).set_compat(true).pack(body);
+		EXPECT_EQ(raw_heads[i], (unsigned char)strcbuf.data()[0]);
+	}
+}
+
+TEST(pack, str_bin_compat)
+{
+	msgpack_object kv[2];
+	std::string body(100, 'x');
+	kv[0].type = MSGPACK_OBJECT_RAW;
+	kv[0].via.raw.ptr = body.data();
+	kv[0].via.raw.size = body.size();
+	kv[1].type = MSGPACK_OBJECT_BIN;
+	kv[1].via.bin.ptr = body.data();
+	kv[1].via.bin.size = body.size();
+	msgpack_object obj;
+	obj.type = MSGPACK_OBJECT_ARRAY;
+	obj.via.array.ptr = kv;
+	obj.via.array.size = 2;
+
+	msgpack_sbuffer sbuf;
+	msgpack_sbuffer_init(&sbuf);
+	msgpack_packer pk;
+	msgpack_packer_init(&pk, &sbuf, msgpack_sbuffer_write);
+
+	msgpack_pack_object(&pk, obj);
+	EXPECT_EQ(1 + 2 + 100 + 2 + 100, sbuf.size);
+	EXPECT_EQ(0xd9, (unsigned char)sbuf.data[1]);
+	EXPECT_EQ(0xc4, (unsigned char)sbuf.data[1 + 2 + 100]);
+
+	// the C++ packer gives the same bytes, for the object and for the
+	// std::string and raw_ref it holds
+	msgpack::sbuffer cxx;
+	msgpack::pack(cxx, msgpack::object(obj));
+	ASSERT_EQ(sbuf.size, cxx.size());
+	EXPECT_EQ(0, memcmp(sbuf.data, cxx.data(), cxx.size()));
+	msgpack::sbuffer cxx_str;
+	msgpack::pack(cxx_str, body);
+	ASSERT_EQ(2 + body.size(), cxx_str.size());
+	EXPECT_EQ(0, memcmp(sbuf.data + 1, cxx_str.data(), cxx_str.size()));
+	msgpack::sbuffer cxx_ref;
+	msgpack::pack(cxx_ref, msgpack::type::raw_ref(body.data(), body.size()));
+	ASSERT_EQ(2 + body.size(), cxx_ref.size());
+	EXPECT_EQ(0, memcmp(sbuf.data + 1, cxx_ref.data(), cxx_ref.size()));
+
+	// only raw 16 headers for the old spec
+	sbuf.size = 0;
+	msgpack_pack_object_compat(&pk, obj);
+	EXPECT_EQ(1 + 3 + 100 + 3 + 100, sbuf.size);
+	EXPECT_EQ(0xda, (unsigned char)sbuf.data[1]);
+	EXPECT_EQ(0xda, (unsigned char)sbuf.data[1 + 3 + 100]);
+
+	msgpack::sbuffer compat;
+	msgpack::packer<msgpack::sbuffer>(compat).set_compat(true).pack(msgpack::object(obj));
+	ASSERT_EQ(sbuf.size, compat.size());
+	EXPECT_EQ(0, memcmp(sbuf.data, compat.data(), compat.size()));
+	msgpack::sbuffer compat_str;
+	msgpack::packer<msgpack::sbuffer>(compat_str).set_compat(true).pack(body);
+	ASSERT_EQ(3 + body.size(), compat_str.size());
+	EXPECT_EQ(0, memcmp(sbuf.data + 1, compat_str.data(), compat_str.size()));
+
+	msgpack_sbuffer_destroy(&sbuf);
+}
+
+TEST(unpack, str_bin_stream)
+{
+	msgpack::sbuffer sbuf;
+	msgpack::packer<msgpack::sbuffer> pk(sbuf);
+	std::string s8(200, 's'), b8(7, 'b'), b16(300, 'c');
+	pk.pack_str(s8.size()).pack_str_body(s8.data(), s8.size());
+	pk.pack_bin(b8.size()).pack_bin_body(b8.data(), b8.size());
+	pk.pack_bin(b16.size()).pack_bin_body(b16.data(), b16.size());
+	pk.pack_bin(0);
+
+	// one byte at a time through every state
+	msgpack::unpacker pac;
+	msgpack::unpacked msg;
+	std::vector<std::string> got;
+	for(size_t i = 0; i < sbuf.size(); ++i) {
+		pac.reserve_buffer(1);
+		pac.buffer()[0] = sbuf.data()[i];
+		pac.buffer_consumed(1);
+		while(pac.next(&msg)) {
+			const msgpack::object& o = msg.get();
+			got.push_back(o.type == msgpack::type::BIN ?
+					"bin:" + std::string(o.via.bin.ptr, o.via.bin.size) :
+					"str:" + std::string(o.via.raw.ptr, o.via.raw.size));
+		}
+	}
+	ASSERT_EQ(4u, got.size());
+	EXPECT_EQ("str:" + s8, got[0]);
+	EXPECT_EQ("bin:" + b8, got[1]);
+	EXPECT_EQ("bin:" + b16, got[2]);
+	EXPECT_EQ("bin:", got[3]);
+}
+
+
+TEST(pack, ext)
+{
+	const size_t lens[] = { 1, 2, 3, 4, 8, 16, 17, 255, 256, 65536 };
+	const unsigned char heads[] = { 0xd4, 0xd5, 0xc7, 0xd6, 0xd7, 0xd8, 0xc7, 0xc7, 0xc8, 0xc9 };
+
+	msgpack::sbuffer sbuf;
+	msgpack::packer<msgpack::sbuffer> pk(sbuf);
+	std::vector<size_t> offs;
+	for(unsigned int i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i) {
+		std::string body(lens[i], 'a' + i);
+		offs.push_back(sbuf.size());
+		pk.pack_ext(body.size(), -(int)i);
+		pk.pack_ext_body(body.data(), body.size());
+	}
+
+	// byte by byte through the streaming states, then in one piece
+	msgpack::unpacker pac;
+	msgpack::unpacked msg;
+	unsigned int count = 0;
+	for(size_t i = 0; i < sbuf.size(); ++i) {
+		pac.reserve_buffer(1);
+		pac.buffer()[0] = sbuf.data()[i];
+		pac.buffer_consumed(1);
+		while(pac.next(&msg)) {
+			const msgpack::object& o = msg.get();
+			EXPECT_EQ(heads[count], (unsigned char)sbuf.data()[offs[count]]);
+			EXPECT_EQ(msgpack::type::EXT, o.type);
+			EXPECT_EQ(-(int)count, o.via.ext.type);
+			EXPECT_EQ(std::string(lens[count], 'a' + count),
+					std::string(o.via.ext.ptr, o.via.ext.size));
+			++count;
+		}
+	}
+	EXPECT_EQ(sizeof(lens) / sizeof(lens[0]), count);
+
+	size_t off = 0;
+	for(unsigned int i = 0; i < count; ++i) {
+		msgpack::unpack(&msg, sbuf.data(), sbuf.size(), &off);
+		msgpack::sbuffer rbuf;
+		msgpack::pack(rbuf, msg.get());
+		EXPECT_EQ(std::string(sbuf.data() + offs[i], off - offs[i]),
+				std::string(rbuf.data(), rbuf.size()));
+	}
+}
+
@@ -1,6 +1,8 @@
 #include <msgpack.hpp>
 #include <gtest/gtest.h>
 #include <sstream>
+#include <pthread.h>
+#include <sched.h>
 
 
 TEST(streaming, basic)
@@ -211,3 +213,302 @@ TEST(streaming, event_compat)
 	handler.on_read();
 }
 
+
+
+TEST(streaming, zone_reuse)
+{
+	std::ostringstream stream;
+	msgpack::packer<std::ostream> pk(&stream);
+	for(int i = 0; i < 100; ++i) {
+		pk.pack(std::vector<int>(i, i));
+	}
+	std::string data(stream.str());
+
+	msgpack::unpacker pac;
+	pac.reserve_buffer(data.size());
+	memcpy(pac.buffer(), data.data(), data.size());
+	pac.buffer_consumed(data.size());
+
+	msgpack::unpacked result;
+	msgpack::zone* z = NULL;
+	int count = 0;
+	while(pac.next(&result)) {
+		if(z == NULL) {
+			z = result.zone().get();
+		}
+		// the zone held by the result is recycled
+		EXPECT_EQ(z, result.zone().get());
+		EXPECT_TRUE(std::vector<int>(count, count) == result.get().as<std::vector<int> >());
+		++count;
+	}
+	EXPECT_EQ(100, count);
+}
+
+TEST(streaming, zone_pool)
+{
+	std::ostringstream stream;
+	msgpack::packer<std::ostream> pk(&stream);
+	for(int i = 0; i < 10; ++i) {
+		pk.pack(std::vector<int>(i, i));
+	}
+	std::string data(stream.str());
+
+	msgpack::unpacker pac;
+	pac.reserve_buffer(data.size());
+	memcpy(pac.buffer(), data.data(), data.size());
+	pac.buffer_consumed(data.size());
+
+	msgpack::zone_pool pool(4);
+	{
+		std::vector<msgpack::pooled_unpacked*> kept;
+		msgpack::pooled_unpacked msg(&pool);
+		while(pac.next(&msg)) {
+			// hand the message off; the next one takes a zone from the pool
+			kept.push_back(new msgpack::pooled_unpacked(&pool));
+			kept.back()->swap(msg);
+		}
+		EXPECT_EQ(NULL, msg.zone());
+		ASSERT_EQ(10u, kept.size());
+		for(size_t i = 0; i < kept.size(); ++i) {
+			EXPECT_TRUE(std::vector<int>(i, i) == kept[i]->get().as<std::vector<int> >());
+			delete kept[i];
+		}
+		EXPECT_EQ(4u, pool.free_size());
+	}
+
+	msgpack::zone* z = pool.acquire();
+	EXPECT_EQ(3u, pool.free_size());
+	pool.release(z);
+	EXPECT_EQ(4u, pool.free_size());
+}
+
+
+TEST(streaming, unpacked_queue)
+{
+	msgpack::sbuffer sbuf;
+	for(int i = 0; i < 10; ++i) {
+		msgpack::pack(sbuf, i);
+	}
+
+	msgpack::unpacker pac;
+	pac.reserve_buffer(sbuf.size());
+	memcpy(pac.buffer(), sbuf.data(), sbuf.size());
+	pac.buffer_consumed(sbuf.size());
+
+	msgpack::zone_pool pool;
+	msgpack::unpacked_queue queue(4);
+
+	std::vector<msgpack::pooled_unpacked*> msgs;
+	for(int i = 0; i < 10; ++i) {
+		msgs.push_back(new msgpack::pooled_unpacked(&pool));
+		ASSERT_TRUE(pac.next(msgs.back()));
+	}
+
+	// the queue holds 4 messages; the rest are left untouched
+	EXPECT_EQ(1u, queue.push(msgs[0]));
+	EXPECT_EQ(NULL, msgs[0]->zone());
+	size_t n = 0;
+	for(int i = 1; i < 10 && queue.push(msgs[i]) == 1; ++i) {
+		++n;
+	}
+	EXPECT_EQ(3u, n);
+	EXPECT_TRUE(msgs[4]->zone() != NULL);
+	EXPECT_EQ(4, msgs[4]->get().as<int>());
+
+	msgpack::queued_unpacked out[8];
+	EXPECT_EQ(4u, queue.pop(out, 8));
+	for(int i = 0; i < 4; ++i) {
+		EXPECT_EQ(i, out[i].get().as<int>());
+	}
+	EXPECT_EQ(0u, queue.pop(out, 8));
+
+	// zones of processed messages find their way back to the pool
+	for(int i = 0; i < 4; ++i) {
+		out[i].reset();
+	}
+	EXPECT_EQ(4u, queue.reclaim(&pool));
+	EXPECT_EQ(4u, pool.free_size());
+
+	for(size_t i = 0; i < msgs.size(); ++i) {
+		delete msgs[i];
+	}
+}
+
+
+struct queue_consumer_arg {
+	msgpack::unpacked_queue* queue;
+	int count;
+	long long sum;
+};
+
+static void* queue_consumer(void* p)
+{
+	queue_consumer_arg* arg = (queue_consumer_arg*)p;
+	msgpack::queued_unpacked out[16];
+	while(arg->count < 10000) {
+		size_t n = arg->queue->pop(out, 16);
+		if(n == 0) {
+			sched_yield();
+		}
+		for(size_t i = 0; i < n; ++i) {
+			arg->sum += out[i].get().as<int>();
+			out[i].reset();
+		}
+		arg->count += n;
+	}
+	return NULL;
+}
+
+TEST(streaming, unpacked_queue_threads)
+{
+	msgpack::sbuffer sbuf;
+	for(int i = 0; i < 10000; ++i) {
+		msgpack::pack(sbuf, i);
+	}
+
+	msgpack::unpacker pac;
+	pac.reserve_buffer(sbuf.size());
+	memcpy(pac.buffer(), sbuf.data(), sbuf.size());
+	pac.buffer_consumed(sbuf.size());
+
+	msgpack::zone_pool pool;
+	msgpack::unpacked_queue queue(64);
+
+	queue_consumer_arg arg = { &queue, 0, 0 };
+	pthread_t th;
+	ASSERT_EQ(0, pthread_create(&th, NULL, queue_consumer, &arg));
+
+	msgpack::pooled_unpacked msg(&pool);
+	while(pac.next(&msg)) {
+		while(queue.push(&msg) == 0) {
+			queue.reclaim(&pool);
+			sched_yield();
+		}
+	}
+
+	pthread_join(th, NULL);
+	EXPECT_EQ(10000, arg.count);
+	EXPECT_EQ(10000LL * 9999 / 2, arg.sum);
+}
+
+
+static void count_release(void* data)
+{
+	++*(int*)data;
+}
+
+TEST(streaming, region)
+{
+	msgpack::sbuffer sbuf;
+	std::vector<std::string> src;
+	for(int i = 0; i < 50; ++i) {
+		src.push_back(std::string(i * 7 + 1, 'a' + i % 26));
+		msgpack::type::tuple<int, std::string> msg(i, src.back());
+		msgpack::pack(sbuf, msg);
+	}
+
+	// split the stream into two regions at every possible point
+	for(size_t split = 0; split <= sbuf.size(); split += 13) {
+		std::vector<char> first(sbuf.data(), sbuf.data() + split);
+		std::vector<char> second(sbuf.data() + split, sbuf.data() + sbuf.size());
+		int released[2] = { 0, 0 };
+
+		{
+			msgpack::unpacker pac;
+			std::vector<msgpack::unpacked*> results;
+			msgpack::unpacked result;
+
+			pac.feed_region(first.empty() ? NULL : &first[0], first.size(),
+					count_release, &released[0]);
+			while(pac.next(&result)) {
+				results.push_back(new msgpack::unpacked(result.get(), result.zone()));
+			}
+			pac.feed_region(second.empty() ? NULL : &second[0], second.size(),
+					count_release, &released[1]);
+			while(pac.next(&result)) {
+				results.push_back(new msgpack::unpacked(result.get(), result.zone()));
+			}
+
+			ASSERT_EQ(50u, results.size());
+			size_t in_place = 0;
+			bool in_second = false;
+			for(int i = 0; i < 50; ++i) {
+				msgpack::type::tuple<int, std::string> msg;
+				results[i]->get().convert(&msg);
+				EXPECT_EQ(i, msg.get<0>());
+				EXPECT_EQ(src[i], msg.get<1>());
+
+				const char* p = results[i]->get().via.array.ptr[1].via.raw.ptr;
+				if(!first.empty() && p >= &first[0] && p < &first[0] + first.size()) {
+					++in_place;
+				} else if(!second.empty() && p >= &second[0] && p < &second[0] + second.size()) {
+					++in_place;
+					in_second = true;
+				}
+			}
+			// only the message across the split may have been copied
+			EXPECT_LE(49u, in_place);
+
+			// the regions stay alive while results refer to them
+			if(in_second) {
+				EXPECT_EQ(0, released[1]);
+			}
+			for(size_t i = 0; i < results.size(); ++i) {
+				delete results[i];
+			}
+		}
+
+		EXPECT_EQ(1, released[0]);
+		EXPECT_EQ(1, released[1]);
+	}
+}
+
+
+TEST(streaming, region_rope)
+{
+	// one large message spread over many regions
+	std::vector<std::string> src;
+	for(int i = 0; i < 200; ++i) {
+		src.push_back(std::string(300 + i, 'a' + i % 26));
+	}
+	msgpack::sbuffer sbuf;
+	msgpack::pack(sbuf, src);
+
+	const size_t chunk = 4000;
+	const size_t nchunks = (sbuf.size() + chunk - 1) / chunk;
+	std::vector<int> released(nchunks, 0);
+
+	msgpack::unpacker pac;
+	msgpack::unpacked result;
+	for(size_t i = 0; i < nchunks; ++i) {
+		size_t len = std::min(chunk, sbuf.size() - i * chunk);
+		pac.feed_region(sbuf.data() + i * chunk, len, count_release, &released[i]);
+		EXPECT_EQ(i + 1 == nchunks, pac.next(&result));
+	}
+
+	msgpack::object obj = result.get();
+	EXPECT_TRUE(src == obj.as<std::vector<std::string> >());
+
+	// only the raws across a boundary were copied
+	size_t in_place = 0;
+	for(uint32_t i = 0; i < obj.via.array.size; ++i) {
+		const char* p = obj.via.array.ptr[i].via.raw.ptr;
+		if(p >= sbuf.data() && p < sbuf.data() + sbuf.size()) {
+			++in_place;
+		}
+	}
+	EXPECT_LE(src.size() - (nchunks - 1), in_place);
+
+	for(size_t i = 0; i < nchunks; ++i) {
+		EXPECT_EQ(0, released[i]);
+	}
+	result.zone().reset();
+	for(size_t i = 0; i + 1 < nchunks; ++i) {
+		EXPECT_EQ(1, released[i]);
+	}
+
+	// the unpacker holds the last region until it has parsed all of it
+	EXPECT_EQ(0, released[nchunks - 1]);
+	EXPECT_FALSE(pac.next(&result));
+	EXPECT_EQ(1, released[nchunks - 1]);
+}
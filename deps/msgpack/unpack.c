@@ -23,9 +23,19 @@
 typedef struct {
 	msgpack_zone* z;
 	bool referenced;
+	msgpack_unpack_limit limit;
+	size_t decoded;  /* bytes claimed by the message so far */
 } unpack_user;
 
 
+/* Containers claiming more elements than this get their storage in steps
+ * instead of at once, so a short header can't claim a huge allocation.
+ * Must be a power of 2. */
+#ifndef MSGPACK_UNPACK_PREALLOC_LIMIT
+#define MSGPACK_UNPACK_PREALLOC_LIMIT 1024
+#endif
+
+
 #define msgpack_unpack_struct(name) \
 	struct template ## name
 
@@ -39,6 +49,8 @@ typedef struct {
 
 #define msgpack_unpack_user unpack_user
 
+#define msgpack_unpack_max_depth(user) ((user)->limit.depth)
+
 
 struct template_context;
 typedef struct template_context template_context;
@@ -52,7 +64,7 @@ static int template_execute(template_context* ctx,
 
 
 static inline msgpack_object template_callback_root(unpack_user* u)
-{ msgpack_object o = {}; return o; }
+{ msgpack_object o = {}; u->decoded = 0; return o; }
 
 static inline int template_callback_uint8(unpack_user* u, uint8_t d, msgpack_object* o)
 { o->type = MSGPACK_OBJECT_POSITIVE_INTEGER; o->via.u64 = d; return 0; }
@@ -97,35 +109,92 @@ static inline int template_callback_true(unpack_user* u, msgpack_object* o)
 static inline int template_callback_false(unpack_user* u, msgpack_object* o)
 { o->type = MSGPACK_OBJECT_BOOLEAN; o->via.boolean = false; return 0; }
 
+/* count `size' more bytes against the limit of the message */
+static inline int claim_decoded(unpack_user* u, size_t size)
+{
+	if(size > u->limit.total - u->decoded) { return -1; }
+	u->decoded += size;
+	return 0;
+}
+
+/* storage for the first elements of a container of `n' */
+static inline size_t prealloc_count(unsigned int n)
+{
+	return n < MSGPACK_UNPACK_PREALLOC_LIMIT ? n : MSGPACK_UNPACK_PREALLOC_LIMIT;
+}
+
+/* Containers larger than the preallocation double their storage whenever
+ * `size' reaches a power of 2 from MSGPACK_UNPACK_PREALLOC_LIMIT on, up to
+ * `size + count' which is the claimed number of elements. */
+static inline bool needs_grow(unsigned int size)
+{
+	return size >= MSGPACK_UNPACK_PREALLOC_LIMIT && (size & (size - 1)) == 0;
+}
+
+static void* grow(unpack_user* u, const void* ptr, unsigned int size, size_t count, size_t elem)
+{
+	size_t n = (size_t)size + (count < size ? count : size);
+	void* p = msgpack_zone_malloc(u->z, n * elem);
+	if(p != NULL) {
+		memcpy(p, ptr, size * elem);
+	}
+	return p;
+}
+
 static inline int template_callback_array(unpack_user* u, unsigned int n, msgpack_object* o)
 {
+	if(n > u->limit.array || claim_decoded(u, (size_t)n * sizeof(msgpack_object)) < 0) {
+		return -1;
+	}
 	o->type = MSGPACK_OBJECT_ARRAY;
 	o->via.array.size = 0;
-	o->via.array.ptr = (msgpack_object*)msgpack_zone_malloc(u->z, n*sizeof(msgpack_object));
+	o->via.array.ptr = (msgpack_object*)msgpack_zone_malloc(u->z, prealloc_count(n)*sizeof(msgpack_object));
 	if(o->via.array.ptr == NULL) { return -1; }
 	return 0;
 }
 
-static inline int template_callback_array_item(unpack_user* u, msgpack_object* c, msgpack_object o)
-{ c->via.array.ptr[c->via.array.size++] = o; return 0; }
+static inline int template_callback_array_item(unpack_user* u, size_t count, msgpack_object* c, msgpack_object o)
+{
+	if(needs_grow(c->via.array.size)) {
+		c->via.array.ptr = (msgpack_object*)grow(u, c->via.array.ptr,
+				c->via.array.size, count, sizeof(msgpack_object));
+		if(c->via.array.ptr == NULL) { return -1; }
+	}
+	c->via.array.ptr[c->via.array.size++] = o;
+	return 0;
+}
 
 static inline int template_callback_map(unpack_user* u, unsigned int n, msgpack_object* o)
 {
+	if(n > u->limit.map || claim_decoded(u, (size_t)n * sizeof(msgpack_object_kv)) < 0) {
+		return -1;
+	}
 	o->type = MSGPACK_OBJECT_MAP;
 	o->via.map.size = 0;
-	o->via.map.ptr = (msgpack_object_kv*)msgpack_zone_malloc(u->z, n*sizeof(msgpack_object_kv));
+	o->via.map.ptr = (msgpack_object_kv*)msgpack_zone_malloc(u->z, prealloc_count(n)*sizeof(msgpack_object_kv));
 	if(o->via.map.ptr == NULL) { return -1; }
 	return 0;
 }
 
-static inline int template_callback_map_item(unpack_user* u, msgpack_object* c, msgpack_object k, msgpack_object v)
+static inline int template_callback_map_item(unpack_user* u, size_t count, msgpack_object* c, msgpack_object k, msgpack_object v)
 {
+	if(needs_grow(c->via.map.size)) {
+		c->via.map.ptr = (msgpack_object_kv*)grow(u, c->via.map.ptr,
+				c->via.map.size, count, sizeof(msgpack_object_kv));
+		if(c->via.map.ptr == NULL) { return -1; }
+	}
 	c->via.map.ptr[c->via.map.size].key = k;
 	c->via.map.ptr[c->via.map.size].val = v;
 	++c->via.map.size;
 	return 0;
 }
 
+static inline int template_callback_raw_header(unpack_user* u, unsigned int l)
+{
+	if(l > u->limit.raw) { return -1; }
+	return claim_decoded(u, l);
+}
+
 static inline int template_callback_raw(unpack_user* u, const char* b, const char* p, unsigned int l, msgpack_object* o)
 {
 	o->type = MSGPACK_OBJECT_RAW;
@@ -135,6 +204,26 @@ static inline int template_callback_raw(unpack_user* u, const char* b, const cha
 	return 0;
 }
 
+static inline int template_callback_bin(unpack_user* u, const char* b, const char* p, unsigned int l, msgpack_object* o)
+{
+	o->type = MSGPACK_OBJECT_BIN;
+	o->via.bin.ptr = p;
+	o->via.bin.size = l;
+	u->referenced = true;
+	return 0;
+}
+
+/* `p' starts with the type byte */
+static inline int template_callback_ext(unpack_user* u, const char* b, const char* p, unsigned int l, msgpack_object* o)
+{
+	o->type = MSGPACK_OBJECT_EXT;
+	o->via.ext.type = *p;
+	o->via.ext.ptr = p + 1;
+	o->via.ext.size = l - 1;
+	u->referenced = true;
+	return 0;
+}
+
 #include "msgpack/unpack_template.h"
 
 
@@ -169,6 +258,29 @@ static inline _msgpack_atomic_counter_t get_count(void* buffer)
 }
 
 
+typedef struct {
+	_msgpack_atomic_counter_t count;
+	void (*release)(void* data);
+	void* data;
+} region_ref;
+
+static inline void decl_region(void* ref)
+{
+	region_ref* r = (region_ref*)ref;
+	if(_msgpack_sync_decr_and_fetch(&r->count) == 0) {
+		if(r->release != NULL) {
+			(*r->release)(r->data);
+		}
+		free(r);
+	}
+}
+
+static inline void incr_region(void* ref)
+{
+	_msgpack_sync_incr_and_fetch(&((region_ref*)ref)->count);
+}
+
+
 
 bool msgpack_unpacker_init(msgpack_unpacker* mpac, size_t initial_buffer_size)
 {
@@ -202,18 +314,27 @@ bool msgpack_unpacker_init(msgpack_unpacker* mpac, size_t initial_buffer_size)
 	mpac->initial_buffer_size = initial_buffer_size;
 	mpac->z = z;
 	mpac->ctx = ctx;
+	mpac->region = NULL;
+	mpac->region_size = 0;
+	mpac->region_off = 0;
+	mpac->region_ref = NULL;
+	mpac->region_referenced = false;
 
 	init_count(mpac->buffer);
 
 	template_init(CTX_CAST(mpac->ctx));
 	CTX_CAST(mpac->ctx)->user.z = mpac->z;
 	CTX_CAST(mpac->ctx)->user.referenced = false;
+	msgpack_unpack_limit_init(&CTX_CAST(mpac->ctx)->user.limit);
 
 	return true;
 }
 
 void msgpack_unpacker_destroy(msgpack_unpacker* mpac)
 {
+	if(mpac->region_ref != NULL) {
+		decl_region(mpac->region_ref);
+	}
 	msgpack_zone_free(mpac->z);
 	free(mpac->ctx);
 	decl_count(mpac->buffer);
@@ -304,7 +425,64 @@ bool msgpack_unpacker_expand_buffer(msgpack_unpacker* mpac, size_t size)
 	return true;
 }
 
-int msgpack_unpacker_execute(msgpack_unpacker* mpac)
+static inline bool append_buffer(msgpack_unpacker* mpac, const char* data, size_t size)
+{
+	if(!msgpack_unpacker_reserve_buffer(mpac, size)) {
+		return false;
+	}
+	memcpy(msgpack_unpacker_buffer(mpac), data, size);
+	msgpack_unpacker_buffer_consumed(mpac, size);
+	return true;
+}
+
+/* stop parsing the region; the message in progress keeps it alive */
+static bool retire_region(msgpack_unpacker* mpac)
+{
+	if(!append_buffer(mpac, mpac->region + mpac->region_off,
+				mpac->region_size - mpac->region_off)) {
+		return false;
+	}
+
+	if(mpac->region_referenced) {
+		if(!msgpack_zone_push_finalizer(mpac->z, decl_region, mpac->region_ref)) {
+			return false;
+		}
+		mpac->region_referenced = false;
+	} else {
+		decl_region(mpac->region_ref);
+	}
+
+	mpac->region = NULL;
+	mpac->region_size = 0;
+	mpac->region_off = 0;
+	mpac->region_ref = NULL;
+	return true;
+}
+
+bool msgpack_unpacker_feed_region(msgpack_unpacker* mpac,
+		const char* data, size_t size,
+		void (*release)(void* data), void* release_data)
+{
+	if(mpac->region_ref != NULL && !retire_region(mpac)) {
+		return false;
+	}
+
+	region_ref* r = (region_ref*)malloc(sizeof(region_ref));
+	if(r == NULL) {
+		return false;
+	}
+	r->count = 1;
+	r->release = release;
+	r->data = release_data;
+
+	mpac->region = data;
+	mpac->region_size = size;
+	mpac->region_off = 0;
+	mpac->region_ref = r;
+	return true;
+}
+
+static int execute_buffer(msgpack_unpacker* mpac)
 {
 	size_t off = mpac->off;
 	int ret = template_execute(CTX_CAST(mpac->ctx),
@@ -315,6 +493,82 @@ int msgpack_unpacker_execute(msgpack_unpacker* mpac)
 	return ret;
 }
 
+static int execute_region(msgpack_unpacker* mpac)
+{
+	// raws found here point into the region, not into the buffer
+	bool buffer_referenced = CTX_REFERENCED(mpac);
+	CTX_REFERENCED(mpac) = false;
+
+	size_t off = mpac->region_off;
+	int ret = template_execute(CTX_CAST(mpac->ctx),
+			mpac->region, mpac->region_size, &mpac->region_off);
+	if(mpac->region_off > off) {
+		mpac->parsed += mpac->region_off - off;
+	}
+
+	if(CTX_REFERENCED(mpac)) {
+		mpac->region_referenced = true;
+	}
+	CTX_REFERENCED(mpac) = buffer_referenced;
+
+	if(ret == 0 && !retire_region(mpac)) {
+		return -1;
+	}
+	return ret;
+}
+
+static int execute_stitched(msgpack_unpacker* mpac)
+{
+	// The token at the end of the buffer straddles into the region. Copy
+	// just the bytes that complete it, then hand whatever the buffer
+	// hasn't parsed back to the region and go on in place.
+	while(true) {
+		int ret = execute_buffer(mpac);
+		if(ret < 0) {
+			return ret;
+		}
+
+		size_t left = mpac->used - mpac->off;
+		if(ret > 0 || left <= mpac->region_off) {
+			// bytes moved in by retire_region() stay in the buffer
+			if(left > mpac->region_off) {
+				left = mpac->region_off;
+			}
+			mpac->region_off -= left;
+			mpac->used -= left;
+			mpac->free += left;
+			return ret > 0 ? ret : execute_region(mpac);
+		}
+
+		size_t rest = mpac->region_size - mpac->region_off;
+		if(rest == 0) {
+			return retire_region(mpac) ? 0 : -1;
+		}
+
+		// the parser is waiting for `trail' bytes, `left' of them are here
+		unsigned int trail = CTX_CAST(mpac->ctx)->trail;
+		size_t n = trail > left ? trail - left : 1;
+		if(n > rest) {
+			n = rest;
+		}
+		if(!append_buffer(mpac, mpac->region + mpac->region_off, n)) {
+			return -1;
+		}
+		mpac->region_off += n;
+	}
+}
+
+int msgpack_unpacker_execute(msgpack_unpacker* mpac)
+{
+	if(mpac->region_ref == NULL) {
+		return execute_buffer(mpac);
+	} else if(mpac->used > mpac->off) {
+		return execute_stitched(mpac);
+	} else {
+		return execute_region(mpac);
+	}
+}
+
 msgpack_object msgpack_unpacker_data(msgpack_unpacker* mpac)
 {
 	return template_data(CTX_CAST(mpac->ctx));
@@ -353,6 +607,15 @@ bool msgpack_unpacker_flush_zone(msgpack_unpacker* mpac)
 		incr_count(mpac->buffer);
 	}
 
+	if(mpac->region_referenced) {
+		if(!msgpack_zone_push_finalizer(mpac->z, decl_region, mpac->region_ref)) {
+			return false;
+		}
+		mpac->region_referenced = false;
+
+		incr_region(mpac->region_ref);
+	}
+
 	return true;
 }
 
@@ -364,15 +627,43 @@ void msgpack_unpacker_reset(msgpack_unpacker* mpac)
 }
 
 
+void msgpack_unpack_limit_init(msgpack_unpack_limit* limit)
+{
+	limit->depth = MSGPACK_EMBED_STACK_SIZE;
+	limit->array = (size_t)-1;
+	limit->map = (size_t)-1;
+	limit->raw = (size_t)-1;
+	limit->total = (size_t)-1;
+}
+
+void msgpack_unpacker_set_limit(msgpack_unpacker* mpac, const msgpack_unpack_limit* limit)
+{
+	CTX_CAST(mpac->ctx)->user.limit = *limit;
+}
+
+
 msgpack_unpack_return
 msgpack_unpack(const char* data, size_t len, size_t* off,
 		msgpack_zone* z, msgpack_object* result)
+{
+	return msgpack_unpack_limited(data, len, off, z, result, NULL);
+}
+
+msgpack_unpack_return
+msgpack_unpack_limited(const char* data, size_t len, size_t* off,
+		msgpack_zone* z, msgpack_object* result,
+		const msgpack_unpack_limit* limit)
 {
 	template_context ctx;
 	template_init(&ctx);
 
 	ctx.user.z = z;
 	ctx.user.referenced = false;
+	if(limit != NULL) {
+		ctx.user.limit = *limit;
+	} else {
+		msgpack_unpack_limit_init(&ctx.user.limit);
+	}
 
 	size_t noff = 0;
 	if(off != NULL) { noff = *off; }
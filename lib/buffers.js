@@ -0,0 +1,25 @@
+// Helpers for lists of Buffers shared by the modules of this package.
+
+var buffer = require('buffer');
+
+// Concatenate the Buffers of `bufs'. A lone Buffer is returned as is.
+var concat = function(bufs) {
+    if (bufs.length == 1) {
+        return bufs[0];
+    }
+
+    var len = 0;
+    bufs.forEach(function(b) {
+        len += b.length;
+    });
+
+    var out = new buffer.Buffer(len);
+    var off = 0;
+    bufs.forEach(function(b) {
+        b.copy(out, off, 0, b.length);
+        off += b.length;
+    });
+
+    return out;
+};
+exports.concat = concat;
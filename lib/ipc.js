@@ -0,0 +1,100 @@
+// MessagePack channels between a process and the children it spawns, over
+// a socketpair of their own rather than the children's stdio or node's
+// JSON IPC.
+//
+//     // parent
+//     var child = msgpack.ipc.spawn(process.execPath, ['worker.js']);
+//     child.channel.addListener('msg', function(m) { ... });
+//     child.channel.send({'job' : 1});
+//
+//     // worker.js
+//     var channel = msgpack.ipc.channel();
+//     channel.addListener('msg', function(m) { channel.send(...); });
+//
+// A channel is a msgpack.Stream with length-framed messages, so a large
+// message is unpacked once it has all arrived, and batched sends: the
+// messages sent in the same tick go out in a single write.
+
+var child_process = require('child_process');
+var mpBindings = require('../build/default/mpBindings');
+var msgpack = require('./msgpack');
+var net = require('net');
+var netBindings = process.binding('net');
+
+// Environment variable telling a child which descriptor is its end
+var ENV_FD = 'MSGPACK_IPC_FD';
+
+// Copy the properties of `o' into a new object
+var copy = function(o) {
+    var c = {};
+    for (var k in o) {
+        c[k] = o[k];
+    }
+
+    return c;
+};
+
+// A channel over the socket `fd'. `opts' are passed to msgpack.Stream.
+var open = function(fd, opts) {
+    var o = copy(opts);
+    o.frames = true;
+    o.batch = true;
+
+    var s = new net.Stream(fd);
+    var ch = new msgpack.Stream(s, o);
+
+    // The socket, to end() the channel or wait for its 'end'
+    ch.stream = s;
+    s.resume();
+
+    return ch;
+};
+
+// Spawn a child process as child_process.spawn() does, with a channel to
+// it as its `channel' property. The child gets its end with channel().
+var spawn = function(command, args, options, opts) {
+    var fds = netBindings.socketpair();
+
+    var o = copy(options);
+    o.env = copy(o.env || process.env);
+    o.env[ENV_FD] = String(fds[1]);
+
+    // Only the child may keep the other end open, or the channel would not
+    // see the end of the child
+    var child;
+    try {
+        mpBindings.setInheritable(fds[1], true);
+        child = child_process.spawn(command, args || [], o);
+    } finally {
+        netBindings.close(fds[1]);
+    }
+
+    child.channel = open(fds[0], opts);
+
+    return child;
+};
+exports.spawn = spawn;
+
+// The channel of this process to its parent, or null if it was not spawned
+// by spawn(). The same channel is returned every time.
+var parentChannel = null;
+var channel = function(opts) {
+    if (parentChannel) {
+        return parentChannel;
+    }
+
+    var env = process.env[ENV_FD];
+    if (env === undefined) {
+        return null;
+    }
+
+    // Keep it from the children of this process
+    var fd = parseInt(env, 10);
+    mpBindings.setInheritable(fd, false);
+    delete process.env[ENV_FD];
+
+    parentChannel = open(fd, opts);
+
+    return parentChannel;
+};
+exports.channel = channel;
@@ -1,72 +1,448 @@
 // Wrap a nicer JavaScript API that wraps the direct MessagePack bindings.
 
 var buffer = require('buffer');
+var buffers = require('./buffers');
 var events = require('events');
 var mpBindings = require('../build/default/mpBindings');
 var sys = require('sys');
 
 var pack = mpBindings.pack;
+var packCompat = mpBindings.packCompat;
+var packWith = mpBindings.packWith;
 var unpack = mpBindings.unpack;
+var crc32c = mpBindings.crc32c;
 
 exports.pack = pack;
+exports.packCompat = packCompat;
+exports.packWith = packWith;
 exports.unpack = unpack;
+exports.unpackInto = mpBindings.unpackInto;
+exports.clone = mpBindings.clone;
+exports.peek = mpBindings.peek;
+exports.patch = mpBindings.patch;
+exports.Int64 = mpBindings.Int64;
+exports.UnpackCache = mpBindings.UnpackCache;
+exports.Encoder = mpBindings.Encoder;
+exports.crc32c = mpBindings.crc32c;
 
-var Stream = function(s) {
+// Drop the consumed bytes from the front of a rope (an Array of Buffers),
+// keeping the last `remaining' bytes. Only the Buffer holding the first
+// unread byte is sliced; nothing is copied.
+var ropeTail = function(rope, remaining) {
+    var i = rope.length;
+    while (remaining > 0 && i > 0) {
+        remaining -= rope[--i].length;
+    }
+
+    var tail = rope.slice(i);
+    if (remaining < 0) {
+        tail[0] = tail[0].slice(-remaining, tail[0].length);
+    }
+
+    return tail;
+};
+
+// The unread byte at `i' of a rope
+var ropeByte = function(rope, i) {
+    for (var j = 0; j < rope.length; j++) {
+        if (i < rope[j].length) {
+            return rope[j][i];
+        }
+        i -= rope[j].length;
+    }
+};
+
+// The bytes [start, end) of a rope, as a rope of slices
+var ropeSlice = function(rope, start, end) {
+    var out = [];
+    for (var j = 0; j < rope.length && end > 0; j++) {
+        var b = rope[j];
+        if (start < b.length) {
+            out.push(b.slice(Math.max(start, 0), Math.min(end, b.length)));
+        }
+        start -= b.length;
+        end -= b.length;
+    }
+
+    return out;
+};
+
+// Frames start with the length of the message, then with its CRC32C if
+// they are checked, both 32-bit big-endian
+var FRAME_HEADER = 4;
+var CHECKED_FRAME_HEADER = 8;
+
+// Largest frame accepted unless `opts.maxFrame' says otherwise
+var MAX_FRAME = 16 * 1024 * 1024;
+
+// The header of the frame of a packed message, with its CRC32C if `checked'
+var makeFrameHeader = function(buf, checked) {
+    var out = new buffer.Buffer(checked ? CHECKED_FRAME_HEADER : FRAME_HEADER);
+    var put32 = function(off, v) {
+        out[off] = (v >>> 24) & 0xff;
+        out[off + 1] = (v >>> 16) & 0xff;
+        out[off + 2] = (v >>> 8) & 0xff;
+        out[off + 3] = v & 0xff;
+    };
+
+    put32(0, buf.length);
+    if (checked) {
+        put32(4, crc32c(buf));
+    }
+
+    return out;
+};
+
+// Put a packed message in a frame, with its CRC32C if `checked'
+var frame = function(buf, checked) {
+    return buffers.concat([makeFrameHeader(buf, checked), buf]);
+};
+
+// Stream of messages over `s'. The optional `opts' are passed to unpack()
+// as limits for every message received, along with `opts.int64' and
+// `opts.cache'; a message exceeding them is an error. Messages are sent
+// with packWith(opts), so `opts.compat', `opts.float32' and `opts.cache'
+// apply to them.
+//
+// With `opts.frames', every message goes in a frame holding its length, so
+// that one arriving in many pieces is parsed once, when it is complete.
+// With `opts.crc32c', frames also hold the CRC32C of their message. Both
+// ends must agree on these. A frame longer than `opts.maxFrame' bytes or
+// failing its checksum is an 'error' and is never unpacked.
+//
+// With `opts.batch', send() queues messages as queue() does.
+var Stream = function(s, opts) {
     var self = this;
+    var packMsg = opts ?
+        function(m) { return packWith(opts, m); } :
+        pack;
+    var checked = !!(opts && opts.crc32c);
+    var framed = checked || !!(opts && opts.frames);
+    var frameHeader = checked ? CHECKED_FRAME_HEADER : FRAME_HEADER;
+    var maxFrame = (opts && opts.maxFrame) || MAX_FRAME;
+    var batch = opts && opts.batch;
 
     events.EventEmitter.call(self);
 
-    // Buffer of incomplete stream data
-    self.buf = null;
+    // Incomplete stream data, as the list of Buffers it arrived in
+    self.bufs = [];
 
     // Send a message down the stream
     // 
     // Allows the caller to pass additional arguments, which are passed
-    // faithfully down to the write() method of the underlying stream.
+    // faithfully down to the write() method of the underlying stream,
+    // unless messages are batched.
     self.send = function(m) {
+        if (batch) {
+            return self.queue(m);
+        }
+
+        arguments[0] = packMsg(m);
+        return self.sendEncoded.apply(self, arguments);
+    };
+
+    // Send a message that has already been packed, e.g. once for many
+    // streams. The Buffer is written as is, so it must not be changed
+    // afterwards. Messages queued before it are written first.
+    self.sendEncoded = function(buf) {
+        self.flush();
+
         // Sigh, no arguments.slice() method
-        var args = [pack(m)];
-        for (i = 1; i < arguments.length; i++) {
+        var args = [framed ? frame(buf, checked) : buf];
+        for (var i = 1; i < arguments.length; i++) {
             args.push(arguments[i]);
         }
 
         return s.write.apply(s, args);
     };
 
+    // Queue a message to be written along with the others queued in this
+    // tick; see queueEncoded()
+    self.queue = function(m) {
+        self.queueEncoded(packMsg(m));
+    };
+
+    // Packed messages queued by queueEncoded() in this tick
+    self.queued = null;
+
+    // Like sendEncoded(), but write all the messages queued in the same
+    // tick at once, as a single Buffer. A lone unframed message is written
+    // without copying it. The optional `headers' object keeps the frame
+    // headers made for `buf', so that Streams it is queued on with the same
+    // one share them; see broadcast().
+    self.queueEncoded = function(buf, headers) {
+        var bufs = [buf];
+        if (framed) {
+            var key = checked ? 'checked' : 'plain';
+            var hdr = headers && headers[key];
+            if (!hdr) {
+                hdr = makeFrameHeader(buf, checked);
+                if (headers) {
+                    headers[key] = hdr;
+                }
+            }
+            bufs.unshift(hdr);
+        }
+
+        if (self.queued) {
+            self.queued.push.apply(self.queued, bufs);
+            return;
+        }
+
+        self.queued = bufs;
+        process.nextTick(self.flush);
+    };
+
+    // Write the messages queued so far, if any
+    self.flush = function() {
+        if (!self.queued) {
+            return;
+        }
+
+        var bufs = self.queued;
+        self.queued = null;
+        s.write(buffers.concat(bufs));
+    };
+
     // Listen for data from the underlying stream, consuming it and emitting
     // 'msg' events as we find whole messages.
     s.addListener('data', function(d) {
-        // Make sure that self.buf reflects the entirety of the unread stream
-        // of bytes; it needs to be a single buffer
-        if (self.buf) {
-            var b = new buffer.Buffer(self.buf.length + d.length);
-            self.buf.copy(b, 0, 0, self.buf.length);
-            d.copy(b, self.buf.length, 0, d.length);
-
-            self.buf = b;
-        } else {
-            self.buf = d;
+        // Keep the unread bytes as they arrived; unpack() parses across
+        // the Buffers of a rope without concatenating them
+        self.bufs.push(d);
+
+        if (framed) {
+            self.readFrames();
+            return;
         }
 
         // Consume messages from the stream, one by one
-        while (self.buf && self.buf.length > 0) {
-            var msg = unpack(self.buf);
+        while (self.bufs.length > 0) {
+            var msg;
+            try {
+                msg = unpack(
+                    (self.bufs.length == 1) ? self.bufs[0] : self.bufs,
+                    opts
+                );
+            } catch (e) {
+                // A message exceeding the limits; where the next one
+                // starts is unknown
+                self.bufs = [];
+                self.emit('error', e);
+                return;
+            }
             if (!msg) {
                 break;
             }
 
             self.emit('msg', msg);
-            if (unpack.bytes_remaining > 0) {
-                self.buf = self.buf.slice(
-                    self.buf.length - unpack.bytes_remaining,
-                    self.buf.length
-                );
-            } else {
-                self.buf = null;
-            }
+            self.bufs = ropeTail(self.bufs, unpack.bytes_remaining);
         }
     });
+
+    // Consume the complete frames from the stream. Checksums are verified
+    // before the message is unpacked.
+    self.readFrames = function() {
+        var avail = 0;
+        self.bufs.forEach(function(b) {
+            avail += b.length;
+        });
+
+        var get32 = function(off) {
+            return ropeByte(self.bufs, off) * 16777216 +
+                ((ropeByte(self.bufs, off + 1) << 16) |
+                 (ropeByte(self.bufs, off + 2) << 8) |
+                 ropeByte(self.bufs, off + 3));
+        };
+
+        while (avail >= frameHeader) {
+            var len = get32(0);
+            if (len > maxFrame) {
+                // The framing can't be trusted any more
+                self.bufs = [];
+                self.emit('error', new Error('Frame of ' + len +
+                                             ' bytes is too large'));
+                return;
+            }
+            if (avail < frameHeader + len) {
+                return;
+            }
+
+            var sum = checked ? get32(4) : 0;
+            var body = ropeSlice(self.bufs, frameHeader, frameHeader + len);
+            avail -= frameHeader + len;
+            self.bufs = ropeTail(self.bufs, avail);
+
+            var crc = 0;
+            if (checked) {
+                body.forEach(function(b) {
+                    crc = crc32c(b, crc);
+                });
+            }
+            if (crc != sum) {
+                // Only this frame is lost, the next one starts after it
+                self.emit('error', new Error('CRC32C mismatch in a frame of ' +
+                                             len + ' bytes'));
+                continue;
+            }
+
+            // The frame is skipped if its message is incomplete, exceeds
+            // the limits or is followed by other bytes
+            var msg = undefined;
+            if (len > 0) {
+                try {
+                    msg = unpack((body.length == 1) ? body[0] : body, opts);
+                } catch (e) {
+                    self.emit('error', e);
+                    continue;
+                }
+            }
+            if (msg === undefined || unpack.bytes_remaining != 0) {
+                self.emit('error', new Error('Frame of ' + len +
+                                             ' bytes holds no single message'));
+                continue;
+            }
+
+            self.emit('msg', msg);
+        }
+    };
 };
 
 sys.inherits(Stream, events.EventEmitter);
 exports.Stream = Stream;
+
+// Pull-based reader of a message too large to unpack at once, such as a
+// huge array of records. Bytes are pushed in as they arrive, and consumed
+// token by token:
+//
+//   {type: 'array', length: n}     the next n values are its elements
+//   {type: 'map', length: n}       the next 2 * n values are its pairs
+//   {type: 'value', value: v}      any other value
+//
+// or a whole value at a time with readValue(). Only the bytes not yet
+// consumed are kept. A value that arrives in many pieces is parsed as they
+// come, each byte once, by a native unpacker that holds its state and the
+// Buffers it needs until the value is complete. `opts' are limits and
+// flags as for unpack().
+var Reader = function(opts) {
+    this.unpacker = new mpBindings.RopeUnpacker(opts);
+
+    // Bytes not yet seen by the unpacker, as the list of Buffers they
+    // arrived in
+    this.bufs = [];
+    this.length = 0;
+};
+
+// Add bytes read from the stream
+Reader.prototype.push = function(buf) {
+    if (buf.length > 0) {
+        this.bufs.push(buf);
+        this.length += buf.length;
+    }
+};
+
+// The unconsumed byte at `i'
+Reader.prototype.byteAt = function(i) {
+    for (var j = 0; j < this.bufs.length; j++) {
+        if (i < this.bufs[j].length) {
+            return this.bufs[j][i];
+        }
+        i -= this.bufs[j].length;
+    }
+};
+
+// Drop everything but the last `remaining' bytes
+Reader.prototype.keep = function(remaining) {
+    this.bufs = ropeTail(this.bufs, remaining);
+    this.length = remaining;
+};
+
+// The next token, or undefined until more bytes are pushed
+Reader.prototype.next = function() {
+    if (this.length == 0) {
+        return undefined;
+    }
+
+    // The rest of a value already started
+    if (this.unpacker.partial()) {
+        var v = this.readValue();
+        return (v === undefined) ? undefined : {type : 'value', value : v};
+    }
+
+    var b = this.byteAt(0);
+    var type = ((b & 0xf0) == 0x90 || b == 0xdc || b == 0xdd) ?
+        'array' :
+        'map';
+    var len, hdr;
+
+    if ((b & 0xe0) == 0x80) {
+        // fixarray and fixmap
+        len = b & 0x0f;
+        hdr = 1;
+    } else if (b == 0xdc || b == 0xde) {
+        if (this.length < 3) {
+            return undefined;
+        }
+        len = (this.byteAt(1) << 8) | this.byteAt(2);
+        hdr = 3;
+    } else if (b == 0xdd || b == 0xdf) {
+        if (this.length < 5) {
+            return undefined;
+        }
+        len = this.byteAt(1) * 16777216 +
+            ((this.byteAt(2) << 16) | (this.byteAt(3) << 8) | this.byteAt(4));
+        hdr = 5;
+    } else {
+        var v = this.readValue();
+        return (v === undefined) ? undefined : {type : 'value', value : v};
+    }
+
+    this.keep(this.length - hdr);
+    return {type : type, length : len};
+};
+
+// The next whole value, or undefined until more bytes are pushed
+Reader.prototype.readValue = function() {
+    if (this.length == 0) {
+        return undefined;
+    }
+
+    var v = this.unpacker.execute(this.bufs);
+    if (v === undefined) {
+        // All of it went into the value in progress
+        this.bufs = [];
+        this.length = 0;
+        return undefined;
+    }
+
+    this.keep(this.unpacker.bytes_remaining);
+    return v;
+};
+
+exports.Reader = Reader;
+
+// Send `m' to every Stream in `streams', packing it only once, with
+// packWith(opts) if `opts' are given. Messages broadcast to a Stream in the
+// same tick are coalesced into one write. Framed Streams share its frame
+// headers, so its CRC32C is computed once too. Returns the packed Buffer.
+var broadcast = function(streams, m, opts) {
+    var buf = opts ? packWith(opts, m) : pack(m);
+    var headers = {};
+
+    streams.forEach(function(s) {
+        s.queueEncoded(buf, headers);
+    });
+
+    return buf;
+};
+
+exports.broadcast = broadcast;
+
+// MessagePack-RPC over Streams; see lib/rpc.js
+exports.rpc = require('./rpc');
+
+// Frame-forwarding router; see lib/router.js
+exports.Router = require('./router').Router;
+
+// Channels to child processes; see lib/ipc.js
+exports.ipc = require('./ipc');
@@ -0,0 +1,163 @@
+// Forward MessagePack frames from any number of source streams to
+// destination streams chosen by a field of each frame, without unpacking
+// and re-packing them.
+
+var buffers = require('./buffers');
+var events = require('events');
+var msgpack = require('./msgpack');
+var sys = require('sys');
+
+// Route frames on the value at `path' in each of them, an Array of map keys
+// and array indexes; see msgpack.peek(). `opts' are limits for the frames,
+// as for msgpack.unpack().
+//
+// Emits 'unroutable' with the frame and the value when there is no route
+// for it, and 'error' when a source sends something that isn't
+// MessagePack.
+var Router = function(path, opts) {
+    events.EventEmitter.call(this);
+
+    this.path = path;
+    this.opts = opts;
+
+    // Routes by the String of the value they are for
+    this.routes = {};
+};
+
+sys.inherits(Router, events.EventEmitter);
+
+// Send frames whose value is `key' to the writable stream `s'
+//
+// Each route has a queue of its own. While `s' is not draining, frames for
+// it are queued and the sources that sent them are paused; once it drains,
+// the queue is written with a single write() and the sources resumed.
+Router.prototype.addRoute = function(key, s) {
+    var route = {
+        stream : s,
+        queue : [],
+        blocked : false,
+        paused : []
+    };
+
+    route.ondrain = function() {
+        if (route.queue.length > 0) {
+            var bufs = route.queue;
+            route.queue = [];
+            if (!s.write(buffers.concat(bufs))) {
+                return;
+            }
+        }
+
+        route.blocked = false;
+        resume(route);
+    };
+
+    s.addListener('drain', route.ondrain);
+
+    this.routes[String(key)] = route;
+};
+
+// Resume the sources paused for `route'
+var resume = function(route) {
+    var paused = route.paused;
+    route.paused = [];
+    paused.forEach(function(src) {
+        src.resume();
+    });
+};
+
+// Stop sending frames for `key' to its stream. The frames still queued for
+// it are emitted as 'unroutable', and the sources waiting for it resumed.
+Router.prototype.removeRoute = function(key) {
+    var self = this;
+    var route = self.routes.hasOwnProperty(String(key)) ?
+        self.routes[String(key)] :
+        null;
+    if (!route) {
+        return;
+    }
+
+    delete self.routes[String(key)];
+    route.stream.removeListener('drain', route.ondrain);
+
+    var queue = route.queue;
+    route.queue = [];
+    queue.forEach(function(frame) {
+        self.emit('unroutable', frame, key);
+    });
+
+    resume(route);
+};
+
+// Forward one frame that came from `src'
+Router.prototype.forward = function(frame, key, src) {
+    var route = this.routes.hasOwnProperty(String(key)) ?
+        this.routes[String(key)] :
+        null;
+    if (!route) {
+        this.emit('unroutable', frame, key);
+        return;
+    }
+
+    if (route.blocked) {
+        route.queue.push(frame);
+    } else if (!route.stream.write(frame)) {
+        route.blocked = true;
+    }
+
+    if (route.blocked && route.paused.indexOf(src) < 0) {
+        route.paused.push(src);
+        src.pause();
+    }
+};
+
+// Read frames from the readable stream `src'
+//
+// The bytes of an incomplete frame are kept as they arrived, and only put
+// together and peeked at again once there are as many as the headers read
+// so far say the frame needs, so that a large frame isn't copied and
+// parsed over and over again.
+Router.prototype.attach = function(src) {
+    var self = this;
+
+    // Bytes of the incomplete frame at the end of what was read, their
+    // length, and the length to wait for before peeking again
+    var pending = [];
+    var length = 0;
+    var needed = 0;
+
+    src.addListener('data', function(d) {
+        pending.push(d);
+        length += d.length;
+        if (length < needed) {
+            return;
+        }
+
+        var buf = buffers.concat(pending);
+        pending = [];
+        length = 0;
+        needed = 0;
+
+        try {
+            var r;
+            while (buf.length > 0 &&
+                   (r = msgpack.peek(buf, self.path, self.opts))) {
+                var frame = buf.slice(0, r[0]);
+                buf = buf.slice(r[0], buf.length);
+
+                self.forward(frame, r[1], src);
+            }
+        } catch (e) {
+            self.emit('error', e);
+            return;
+        }
+
+        if (buf.length > 0) {
+            pending = [buf];
+            length = buf.length;
+            needed = msgpack.peek.bytes_needed;
+        }
+    });
+};
+
+exports.Router = Router;
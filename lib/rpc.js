@@ -0,0 +1,203 @@
+// MessagePack-RPC (http://wiki.msgpack.org/display/MSGPACK/RPC+specification)
+// over msgpack.Stream.
+//
+// Either end of a connection can both make calls and answer them:
+//
+//     [0, id, method, params]      request
+//     [1, id, error, result]       response
+//     [2, method, params]          notification
+//
+// Every call gets its own id, so any number of them can be in flight on one
+// connection and their responses may come back in any order. Requests and
+// responses made in the same tick are coalesced into a single write.
+
+var events = require('events');
+var msgpack = require('./msgpack');
+var net = require('net');
+var sys = require('sys');
+
+var REQUEST = 0;
+var RESPONSE = 1;
+var NOTIFICATION = 2;
+
+// An RPC session over the net.Stream `s'. Incoming requests and
+// notifications are dispatched to the functions of `handlers' by method
+// name, as handler(params, reply) where `params' is the Array of
+// arguments and reply(err, result) sends the response; notifications get
+// a reply() that does nothing.
+//
+// `opts' are passed to msgpack.Stream, and `opts.timeout' is the default
+// number of milliseconds a call waits for its response, or 0 for ever.
+var Session = function(s, handlers, opts) {
+    var self = this;
+
+    events.EventEmitter.call(self);
+
+    self.stream = new msgpack.Stream(s, opts);
+    self.handlers = handlers || {};
+    self.timeout = (opts && opts.timeout) || 0;
+
+    // Callbacks of the calls in flight, by id
+    self.pending = {};
+    self.nextId = 0;
+
+    self.stream.addListener('msg', function(m) {
+        if (!Array.isArray(m)) {
+            self.emit('error', new Error('Malformed MessagePack-RPC message'));
+            return;
+        }
+
+        switch (m[0]) {
+        case REQUEST:
+            self.dispatch(m[2], m[3], function(err, result) {
+                self.stream.queue([RESPONSE, m[1], err, result]);
+            });
+            break;
+
+        case RESPONSE:
+            self.complete(m[1], m[2], m[3]);
+            break;
+
+        case NOTIFICATION:
+            self.dispatch(m[1], m[2], function() {});
+            break;
+
+        default:
+            self.emit('error', new Error('Malformed MessagePack-RPC message'));
+        }
+    });
+
+    // Calls still in flight never get their responses
+    s.addListener('close', function() {
+        self.failAll(new Error('Connection closed'));
+    });
+};
+
+sys.inherits(Session, events.EventEmitter);
+
+// session.call(method, params[, opts], callback)
+//
+// Call `method' on the other end with the Array of arguments `params'.
+// callback(err, result) gets the error or the result of the response, or
+// an Error if it does not arrive within `opts.timeout' milliseconds.
+Session.prototype.call = function(method, params, opts, callback) {
+    var self = this;
+
+    if (typeof opts == 'function') {
+        callback = opts;
+        opts = null;
+    }
+
+    // Ids are unsigned 32-bit integers
+    var id = self.nextId;
+    self.nextId = (self.nextId + 1) % 4294967296;
+
+    var call = {callback : callback, timer : null};
+    var timeout = (opts && opts.timeout !== undefined) ?
+        opts.timeout :
+        self.timeout;
+    if (timeout > 0) {
+        call.timer = setTimeout(function() {
+            delete self.pending[id];
+            callback(new Error('Call to ' + method + ' timed out'));
+        }, timeout);
+    }
+
+    self.pending[id] = call;
+    self.stream.queue([REQUEST, id, method, params || []]);
+};
+
+// session.notify(method, params)
+//
+// Call `method' on the other end without waiting for a response.
+Session.prototype.notify = function(method, params) {
+    this.stream.queue([NOTIFICATION, method, params || []]);
+};
+
+// Run the handler of an incoming request or notification
+Session.prototype.dispatch = function(method, params, reply) {
+    var handler = this.handlers.hasOwnProperty(method) ?
+        this.handlers[method] :
+        null;
+    if (typeof handler != 'function') {
+        reply('No such method: ' + method, null);
+        return;
+    }
+
+    try {
+        handler(params, function(err, result) {
+            // An Error's message is not enumerable, so it would be sent
+            // as an empty map
+            if (err instanceof Error) {
+                err = String(err.message);
+            }
+
+            reply((err === undefined) ? null : err,
+                  (result === undefined) ? null : result);
+        });
+    } catch (e) {
+        reply(String(e.message || e), null);
+    }
+};
+
+// Hand a response to the call it answers; late ones are dropped
+Session.prototype.complete = function(id, err, result) {
+    var call = this.pending[id];
+    if (!call) {
+        return;
+    }
+
+    delete this.pending[id];
+    if (call.timer) {
+        clearTimeout(call.timer);
+    }
+
+    call.callback(err, result);
+};
+
+// Fail every call in flight with `err'
+Session.prototype.failAll = function(err) {
+    var pending = this.pending;
+    this.pending = {};
+
+    for (var id in pending) {
+        if (pending[id].timer) {
+            clearTimeout(pending[id].timer);
+        }
+        pending[id].callback(err);
+    }
+};
+
+exports.Session = Session;
+
+// Create a net.Server answering calls with `handlers' on every connection.
+// Each new Session is emitted as a 'session' event.
+var createServer = function(handlers, opts) {
+    var server = net.createServer(function(s) {
+        server.emit('session', new Session(s, handlers, opts));
+    });
+
+    return server;
+};
+
+exports.createServer = createServer;
+
+// Connect to a server and return the Session; calls made before the
+// connection is up are sent once it is.
+var connect = function(port, host, handlers, opts) {
+    return new Session(net.createConnection(port, host), handlers, opts);
+};
+
+exports.connect = connect;
+
+// A server with a single method, echo, that returns its arguments; for
+// tests and for measuring the overhead of a call.
+var createEchoServer = function(opts) {
+    return createServer({
+        echo : function(params, reply) {
+            reply(null, params);
+        }
+    }, opts);
+};
+
+exports.createEchoServer = createEchoServer;
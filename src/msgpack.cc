@@ -5,13 +5,26 @@
 #include <node_buffer.h>
 #include <msgpack.h>
 #include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <float.h>
+#include <stdio.h>
 #include <list>
+#include <map>
+#include <set>
+#include <string>
 #include <assert.h>
 
 using namespace v8;
 using namespace node;
 
 static Persistent<FunctionTemplate> msgpack_unpack_template;
+static Persistent<FunctionTemplate> msgpack_int64_template;
+static Persistent<String> msgpack_slice_symbol;
+static Persistent<String> msgpack_hi_symbol;
+static Persistent<String> msgpack_lo_symbol;
+static Persistent<String> msgpack_length_symbol;
+static Persistent<String> msgpack_value_symbol;
 
 // An exception class that wraps a textual message
 class MsgpackException {
@@ -56,6 +69,20 @@ class MsgpackSbuffer {
         }
 };
 
+// A holder for a msgpack_unpacker object; ensures destruction on scope exit
+class MsgpackUnpacker {
+    public:
+        msgpack_unpacker _mu;
+
+        MsgpackUnpacker(size_t sz = 1024) {
+            msgpack_unpacker_init(&this->_mu, sz);
+        }
+
+        ~MsgpackUnpacker() {
+            msgpack_unpacker_destroy(&this->_mu);
+        }
+};
+
 // Object to check for cycles when packing.
 class MsgpackCycle {
     public:
@@ -94,6 +121,40 @@ class MsgpackCycle {
         std::list< Handle<Value> > _objs;
 };
 
+// The Buffers that an object is being unpacked from, so that bin objects
+// can be returned as slices of them rather than as copies.
+class MsgpackSources {
+    public:
+        void add(Handle<Object> buf) {
+            _bufs.push_back(buf);
+        }
+
+        Handle<Value> slice(const char *ptr, size_t len) {
+            for (std::list< Handle<Object> >::iterator iter = _bufs.begin();
+                 iter != _bufs.end();
+                 iter++) {
+                const char *data = Buffer::Data(*iter);
+                if (ptr >= data && ptr + len <= data + Buffer::Length(*iter)) {
+                    Handle<Value> argv[2] = {
+                        Integer::New(ptr - data),
+                        Integer::New(ptr - data + len)
+                    };
+                    Handle<Function> f = Handle<Function>::Cast(
+                        (*iter)->Get(msgpack_slice_symbol)
+                    );
+                    return f->Call(*iter, 2, argv);
+                }
+            }
+
+            // Straddled two Buffers of a rope, so it was copied anyway
+            Buffer *bp = Buffer::New((char*) ptr, len);
+            return bp->handle_;
+        }
+
+    private:
+        std::list< Handle<Object> > _bufs;
+};
+
 #define DBG_PRINT_BUF(buf, name) \
     do { \
         fprintf(stderr, "Buffer %s has %lu bytes:\n", \
@@ -113,25 +174,365 @@ class MsgpackCycle {
         } \
     } while (0)
 
+// Flags for v8_to_msgpack()
+enum {
+    PACK_COMPAT = 1 << 0,   // old spec; no str 8, bin or ext
+    PACK_FLOAT32 = 1 << 1,  // doubles that float32 holds exactly as float
+    PACK_CACHE = 1 << 2     // cache the encoding of frozen objects
+};
+
+// Flags for msgpack_to_v8()
+enum {
+    UNPACK_INT64 = 1 << 0   // integers beyond 2^53 as Int64 objects
+};
+
+// Whether `hi' is an integer that the high word of an int64 or uint64 holds
+static bool
+int64_hi_valid(double hi) {
+    return hi == floor(hi) && hi >= -2147483648.0 && hi < 4294967296.0;
+}
+
+// var i = new msgpack.Int64(hi, lo);
+//
+// A 64-bit integer that a Number can't hold exactly, as hi * 2^32 + lo.
+// A negative `hi' makes it signed, so both int64 and uint64 values fit.
+// Packs as the integer it holds.
+static Handle<Value>
+int64_new(const Arguments &args) {
+    HandleScope scope;
+
+    if (!int64_hi_valid(args[0]->NumberValue())) {
+        return ThrowException(Exception::RangeError(
+            String::New("Int64 hi must be an integer in [-2^31, 2^32)")));
+    }
+
+    args.This()->Set(msgpack_hi_symbol, Number::New(args[0]->NumberValue()));
+    args.This()->Set(msgpack_lo_symbol, Number::New(args[1]->Uint32Value()));
+
+    return args.This();
+}
+
+// Convert an Int64 object to a MessagePack integer. Throws a
+// MsgpackException if its `hi' has been changed to an invalid one.
+static void
+int64_to_msgpack(Handle<Object> o, msgpack_object *mo) {
+    double hi = o->Get(msgpack_hi_symbol)->NumberValue();
+    uint32_t lo = o->Get(msgpack_lo_symbol)->Uint32Value();
+
+    if (!int64_hi_valid(hi)) {
+        throw MsgpackException("Int64 hi must be an integer in [-2^31, 2^32)");
+    }
+
+    if (hi < 0) {
+        mo->type = MSGPACK_OBJECT_NEGATIVE_INTEGER;
+        mo->via.i64 = (int64_t) (((uint64_t) (int64_t) hi << 32) | lo);
+    } else {
+        mo->type = MSGPACK_OBJECT_POSITIVE_INTEGER;
+        mo->via.u64 = ((uint64_t) (uint32_t) hi << 32) | lo;
+    }
+}
+
+// Create an Int64 object holding `d', or its two's complement if `neg'
+static Handle<Value>
+int64_from_msgpack(uint64_t d, bool neg) {
+    Handle<Value> argv[2] = {
+        neg ? Number::New((int32_t) (d >> 32)) :
+              Number::New((uint32_t) (d >> 32)),
+        Number::New((uint32_t) d)
+    };
+
+    return msgpack_int64_template->GetFunction()->NewInstance(2, argv);
+}
+
+// i.toString()
+//
+// The decimal digits of the exact value.
+static Handle<Value>
+int64_to_string(const Arguments &args) {
+    HandleScope scope;
+
+    msgpack_object mo;
+    char buf[24];
+
+    try {
+        int64_to_msgpack(args.This(), &mo);
+    } catch (MsgpackException e) {
+        return ThrowException(e.getThrownException());
+    }
+    if (mo.type == MSGPACK_OBJECT_NEGATIVE_INTEGER) {
+        snprintf(buf, sizeof(buf), "%lld", (long long) mo.via.i64);
+    } else {
+        snprintf(buf, sizeof(buf), "%llu", (unsigned long long) mo.via.u64);
+    }
+
+    return scope.Close(String::New(buf));
+}
+
+// i.valueOf()
+//
+// The nearest Number, for comparisons and arithmetic that can be lossy.
+static Handle<Value>
+int64_value_of(const Arguments &args) {
+    HandleScope scope;
+
+    double hi = args.This()->Get(msgpack_hi_symbol)->NumberValue();
+    double lo = args.This()->Get(msgpack_lo_symbol)->NumberValue();
+
+    return scope.Close(Number::New(hi * 4294967296.0 + lo));
+}
+
+// Ext type of the timestamps that Date objects are packed as
+#define MSGPACK_EXT_TIMESTAMP -1
+
+// Pack milliseconds since the epoch as a timestamp, in the smallest of its
+// three forms that holds them:
+//
+//   4 bytes:  32-bit unsigned seconds
+//   8 bytes:  30-bit nanoseconds, then 34-bit unsigned seconds
+//  12 bytes:  32-bit nanoseconds, then 64-bit signed seconds
+static void
+date_to_msgpack(double ms, msgpack_object *mo, msgpack_zone *mz) {
+    double s = floor(ms / 1000);
+    int64_t sec = (int64_t) s;
+    uint32_t nsec = (uint32_t) ((ms - s * 1000) * 1000000);
+
+    char *p = (char*) msgpack_zone_malloc(mz, 12);
+
+    mo->type = MSGPACK_OBJECT_EXT;
+    mo->via.ext.type = MSGPACK_EXT_TIMESTAMP;
+    mo->via.ext.ptr = p;
+
+    if ((sec >> 34) == 0) {
+        uint64_t d = ((uint64_t) nsec << 34) | (uint64_t) sec;
+        if ((d >> 32) == 0) {
+            _msgpack_store32(p, (uint32_t) d);
+            mo->via.ext.size = 4;
+        } else {
+            _msgpack_store64(p, d);
+            mo->via.ext.size = 8;
+        }
+    } else {
+        _msgpack_store32(p, nsec);
+        _msgpack_store64(p + 4, sec);
+        mo->via.ext.size = 12;
+    }
+}
+
+// Whether packing `d' as a float loses nothing. NaN and the infinities
+// survive the conversion, and out-of-range values must not be converted.
+static inline bool
+float32_exact(double d) {
+    if (isnan(d) || isinf(d)) {
+        return true;
+    }
+
+    return fabs(d) <= FLT_MAX && (double) (float) d == d;
+}
+
+// Binding-only object type: bytes that are already encoded, in via.bin.
+// Splices the cached encoding of a frozen object into the output.
+#define MSGPACK_OBJECT_ENCODED ((msgpack_object_type) 0x0f)
+
+// msgpack_pack_object(), or msgpack_pack_object_compat() in PACK_COMPAT
+// mode, that also writes MSGPACK_OBJECT_ENCODED objects anywhere in the
+// tree.
+static int
+pack_msgpack_object(msgpack_packer *pk, msgpack_object *mo, int flags) {
+    switch (mo->type) {
+    case MSGPACK_OBJECT_ENCODED:
+        return (*pk->callback)(pk->data, mo->via.bin.ptr, mo->via.bin.size);
+
+    case MSGPACK_OBJECT_ARRAY:
+        if (msgpack_pack_array(pk, mo->via.array.size)) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < mo->via.array.size; i++) {
+            if (pack_msgpack_object(pk, &mo->via.array.ptr[i], flags)) {
+                return -1;
+            }
+        }
+        return 0;
+
+    case MSGPACK_OBJECT_MAP:
+        if (msgpack_pack_map(pk, mo->via.map.size)) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < mo->via.map.size; i++) {
+            if (pack_msgpack_object(pk, &mo->via.map.ptr[i].key, flags) ||
+                pack_msgpack_object(pk, &mo->via.map.ptr[i].val, flags)) {
+                return -1;
+            }
+        }
+        return 0;
+
+    default:
+        return (flags & PACK_COMPAT) ?
+            msgpack_pack_object_compat(pk, *mo) :
+            msgpack_pack_object(pk, *mo);
+    }
+}
+
+static Persistent<Function> msgpack_is_frozen;
+static Persistent<Function> msgpack_freeze;
+static Persistent<Function> msgpack_get_own_property_descriptor;
+static Persistent<Value> msgpack_object_prototype;
+static Persistent<Value> msgpack_array_prototype;
+
+// Hidden properties holding the cached encoding of a frozen object, one
+// for each combination of the flags that change the bytes
+#define PACK_CACHE_VARIANTS ((PACK_COMPAT | PACK_FLOAT32) + 1)
+static Persistent<String> msgpack_cache_symbols[PACK_CACHE_VARIANTS];
+
+// Object.isFrozen(v)
+static bool
+is_frozen(Handle<Value> v) {
+    return msgpack_is_frozen->Call(
+        Context::GetCurrent()->Global(), 1, &v
+    )->BooleanValue();
+}
+
+// Whether the frozen `o' packs to the same bytes for as long as it lives:
+// a plain Array or Object whose enumerable properties are all its own data
+// properties. A getter or a property inherited from a prototype that
+// isn't frozen could give something else next time.
+static bool
+is_plain_data(Handle<Object> o) {
+    Handle<Value> proto = o->GetPrototype();
+    if (!proto->StrictEquals(o->IsArray() ?
+                             msgpack_array_prototype :
+                             msgpack_object_prototype)) {
+        return false;
+    }
+
+    Local<Array> names = o->GetPropertyNames();
+    for (uint32_t i = 0, l = names->Length(); i < l; i++) {
+        Handle<Value> argv[2] = { o, names->Get(i) };
+        Local<Value> d = msgpack_get_own_property_descriptor->Call(
+            Context::GetCurrent()->Global(), 2, argv);
+        if (!d->IsObject() || !d->ToObject()->Has(msgpack_value_symbol)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Look up the cached encoding of `o' in PACK_CACHE mode
+static bool
+cache_get(Handle<Object> o, msgpack_object *mo, int flags) {
+    Local<Value> v = o->GetHiddenValue(
+        msgpack_cache_symbols[flags & (PACK_COMPAT | PACK_FLOAT32)]);
+    if (v.IsEmpty() || !Buffer::HasInstance(v)) {
+        return false;
+    }
+
+    mo->type = MSGPACK_OBJECT_ENCODED;
+    mo->via.bin.ptr = Buffer::Data(v->ToObject());
+    mo->via.bin.size = Buffer::Length(v->ToObject());
+    return true;
+}
+
+// Encode `mo', the conversion of the frozen `o', and keep the bytes on
+// `o' so that they are freed along with it. `mo' is replaced by them.
+static void
+cache_put(Handle<Object> o, msgpack_object *mo, int flags) {
+    msgpack_packer pk;
+    MsgpackSbuffer sb;
+
+    msgpack_packer_init(&pk, &sb._sbuf, msgpack_sbuffer_write);
+    if (pack_msgpack_object(&pk, mo, flags)) {
+        throw MsgpackException("Error serializaing object");
+    }
+
+    Buffer *bp = Buffer::New(sb._sbuf.data, sb._sbuf.size);
+    o->SetHiddenValue(
+        msgpack_cache_symbols[flags & (PACK_COMPAT | PACK_FLOAT32)],
+        bp->handle_);
+
+    mo->type = MSGPACK_OBJECT_ENCODED;
+    mo->via.bin.ptr = Buffer::Data(bp);
+    mo->via.bin.size = Buffer::Length(bp);
+}
+
+// Pin a number to the widest encoding of its kind, int64 (uint64 above
+// its range) or double, so that it can be patched in place with any other
+// value later; see patch(). Other objects are left alone.
+static void
+pin_width(msgpack_object *mo, msgpack_zone *mz) {
+    unsigned char *p;
+
+    switch (mo->type) {
+    case MSGPACK_OBJECT_POSITIVE_INTEGER:
+        p = (unsigned char*) msgpack_zone_malloc(mz, 9);
+        p[0] = (mo->via.u64 > 0x7fffffffffffffffULL) ? 0xcf : 0xd3;
+        _msgpack_store64(p + 1, mo->via.u64);
+        break;
+
+    case MSGPACK_OBJECT_NEGATIVE_INTEGER:
+        p = (unsigned char*) msgpack_zone_malloc(mz, 9);
+        p[0] = 0xd3;
+        _msgpack_store64(p + 1, (uint64_t) mo->via.i64);
+        break;
+
+    case MSGPACK_OBJECT_DOUBLE:
+    case MSGPACK_OBJECT_FLOAT: {
+        uint64_t d;
+        memcpy(&d, &mo->via.dec, 8);
+        p = (unsigned char*) msgpack_zone_malloc(mz, 9);
+        p[0] = 0xcb;
+        _msgpack_store64(p + 1, d);
+        break;
+    }
+
+    default:
+        return;
+    }
+
+    mo->type = MSGPACK_OBJECT_ENCODED;
+    mo->via.bin.ptr = (const char*) p;
+    mo->via.bin.size = 9;
+}
+
 // Convert a V8 object to a MessagePack object.
 //
 // This method is recursive. It will probably blow out the stack on objects
 // with extremely deep nesting.
 //
 // If a circular reference is detected, an exception is thrown.
-static void
+//
+// Returns whether the result can never change: primitives, and in
+// PACK_CACHE mode frozen arrays and objects holding only such values. The
+// latter are converted to MSGPACK_OBJECT_ENCODED, encoded only the first
+// time they are packed.
+//
+// Numbers that are the values of the map keys in `pins' are pinned to
+// their widest encoding with pin_width().
+static bool
 v8_to_msgpack(Handle<Value> v8obj, msgpack_object *mo, msgpack_zone *mz,
-              MsgpackCycle *mc) {
+              MsgpackCycle *mc, int flags,
+              const std::set<std::string> *pins = NULL) {
 
     if (v8obj->IsUndefined() || v8obj->IsNull()) {
         mo->type = MSGPACK_OBJECT_NIL;
     } else if (v8obj->IsBoolean()) {
         mo->type = MSGPACK_OBJECT_BOOLEAN;
         mo->via.boolean = v8obj->BooleanValue();
+    } else if (v8obj->IsInt32()) {
+        int32_t i = v8obj->Int32Value();
+        if (i > 0) {
+            mo->type = MSGPACK_OBJECT_POSITIVE_INTEGER;
+            mo->via.u64 = i;
+        } else {
+            mo->type = MSGPACK_OBJECT_NEGATIVE_INTEGER;
+            mo->via.i64 = i;
+        }
     } else if (v8obj->IsNumber()) {
         double d = v8obj->NumberValue();
-        if (trunc(d) != d) {
-            mo->type = MSGPACK_OBJECT_DOUBLE;
+        if (trunc(d) != d || d >= 18446744073709551616.0 ||
+            d < -9223372036854775808.0) {
+            mo->type = (flags & PACK_FLOAT32) && float32_exact(d) ?
+                MSGPACK_OBJECT_FLOAT :
+                MSGPACK_OBJECT_DOUBLE;
             mo->via.dec = d;
         } else if (d > 0) {
             mo->type = MSGPACK_OBJECT_POSITIVE_INTEGER;
@@ -141,65 +542,146 @@ v8_to_msgpack(Handle<Value> v8obj, msgpack_object *mo, msgpack_zone *mz,
             mo->via.i64 = d;
         }
     } else if (v8obj->IsString()) {
+        // Transcode straight into the zone rather than through a
+        // temporary copy
+        Handle<String> str = v8obj->ToString();
         mo->type = MSGPACK_OBJECT_RAW;
-        String::Utf8Value utf8value(v8obj);
-        mo->via.raw.size = utf8value.length();
+        mo->via.raw.size = str->Utf8Length();
         mo->via.raw.ptr = (char*) msgpack_zone_malloc(mz, mo->via.raw.size);
 
-        memcpy((char*) mo->via.raw.ptr, *utf8value, mo->via.raw.size);
-    } else if (v8obj->IsArray()) {
-        mc->enter(v8obj);
-
-        Handle<Array> a = Handle<Array>::Cast(v8obj);
-
-        mo->type = MSGPACK_OBJECT_ARRAY;
-        mo->via.array.size = a->Length();
-        mo->via.array.ptr = (msgpack_object*) msgpack_zone_malloc(
-            mz,
-            sizeof(msgpack_object) * mo->via.array.size
-        );
-
-        for (uint32_t i = 0, l = a->Length(); i < l; i++) {
-            v8_to_msgpack(a->Get(i), &mo->via.array.ptr[i], mz, mc);
+        str->WriteUtf8((char*) mo->via.raw.ptr, mo->via.raw.size);
+    } else if (v8obj->IsDate()) {
+        double ms = v8obj->NumberValue();
+        if (isnan(ms)) {
+            // Invalid Date
+            mo->type = MSGPACK_OBJECT_NIL;
+        } else if (flags & PACK_COMPAT) {
+            v8_to_msgpack(Number::New(ms), mo, mz, mc, flags, pins);
+        } else {
+            date_to_msgpack(ms, mo, mz);
         }
 
-        mc->out();
+        // setTime() works on frozen Dates too
+        return false;
+    } else if (msgpack_int64_template->HasInstance(v8obj)) {
+        int64_to_msgpack(v8obj->ToObject(), mo);
+        return false;
     } else if (Buffer::HasInstance(v8obj)) {
         Handle<Object> buf = Handle<Object>::Cast(v8obj);
 
-        mo->type = MSGPACK_OBJECT_RAW;
-        mo->via.raw.size = Buffer::Length(buf);
-        mo->via.raw.ptr = Buffer::Data(buf);
+        mo->type = MSGPACK_OBJECT_BIN;
+        mo->via.bin.size = Buffer::Length(buf);
+        mo->via.bin.ptr = Buffer::Data(buf);
+        return false;
     } else {
+        Handle<Object> o = v8obj->ToObject();
+
+        // A cached object was checked for cycles when it was encoded, and
+        // can't reach anything that isn't frozen
+        if ((flags & PACK_CACHE) && cache_get(o, mo, flags)) {
+            return true;
+        }
+
+        bool immutable = true;
+
         mc->enter(v8obj);
 
-        Handle<Object> o = Handle<Object>::Cast(v8obj);
-        Local<Array> a = o->GetPropertyNames();
+        if (v8obj->IsArray()) {
+            Handle<Array> a = Handle<Array>::Cast(v8obj);
 
-        mo->type = MSGPACK_OBJECT_MAP;
-        mo->via.map.size = a->Length();
-        mo->via.map.ptr = (msgpack_object_kv*) msgpack_zone_malloc(
-            mz,
-            sizeof(msgpack_object_kv) * mo->via.map.size
-        );
+            mo->type = MSGPACK_OBJECT_ARRAY;
+            mo->via.array.size = a->Length();
+            mo->via.array.ptr = (msgpack_object*) msgpack_zone_malloc(
+                mz,
+                sizeof(msgpack_object) * mo->via.array.size
+            );
+
+            for (uint32_t i = 0, l = a->Length(); i < l; i++) {
+                immutable &= v8_to_msgpack(
+                    a->Get(i), &mo->via.array.ptr[i], mz, mc, flags, pins);
+            }
+        } else {
+            Local<Array> a = o->GetPropertyNames();
+
+            mo->type = MSGPACK_OBJECT_MAP;
+            mo->via.map.size = a->Length();
+            mo->via.map.ptr = (msgpack_object_kv*) msgpack_zone_malloc(
+                mz,
+                sizeof(msgpack_object_kv) * mo->via.map.size
+            );
+
+            for (uint32_t i = 0, l = a->Length(); i < l; i++) {
+                Local<Value> k = a->Get(i);
 
-        for (uint32_t i = 0, l = a->Length(); i < l; i++) {
-            Local<Value> k = a->Get(i);
+                msgpack_object_kv *kv = &mo->via.map.ptr[i];
 
-            v8_to_msgpack(k, &mo->via.map.ptr[i].key, mz, mc);
-            v8_to_msgpack(o->Get(k), &mo->via.map.ptr[i].val, mz, mc);
+                v8_to_msgpack(k, &kv->key, mz, mc, flags, pins);
+                immutable &= v8_to_msgpack(
+                    o->Get(k), &kv->val, mz, mc, flags, pins);
+
+                if (pins && kv->key.type == MSGPACK_OBJECT_RAW &&
+                    pins->count(std::string(kv->key.via.raw.ptr,
+                                            kv->key.via.raw.size))) {
+                    pin_width(&kv->val, mz);
+                }
+            }
         }
 
         mc->out();
+
+        if (!(flags & PACK_CACHE) || !immutable || !is_frozen(v8obj) ||
+            !is_plain_data(o)) {
+            return false;
+        }
+
+        cache_put(o, mo, flags);
+    }
+
+    return true;
+}
+
+// Convert a timestamp back to a Date
+static Handle<Value>
+msgpack_to_date(msgpack_object_ext *ext) {
+    const char *p = ext->ptr;
+    double sec, nsec;
+
+    switch (ext->size) {
+    case 4:
+        sec = _msgpack_load32(uint32_t, p);
+        nsec = 0;
+        break;
+
+    case 8: {
+        uint64_t d = _msgpack_load64(uint64_t, p);
+        sec = d & 0x3ffffffffULL;
+        nsec = d >> 34;
+        break;
+    }
+
+    case 12:
+        nsec = _msgpack_load32(uint32_t, p);
+        sec = _msgpack_load64(int64_t, (p + 4));
+        break;
+
+    default:
+        throw MsgpackException("Encountered malformed MessagePack timestamp");
     }
+
+    return Date::New(sec * 1000 + floor(nsec / 1000000));
 }
 
-// Convert a MessagePack object to a V8 object.
+// Convert a MessagePack object to a V8 object. Bin objects become slices of
+// the Buffers in `ms' that they point into.
+//
+// Integers that fit 32 bits become Integers, and the rest Numbers as long
+// as they are exact. Beyond 2^53 they become Int64 objects in UNPACK_INT64
+// mode, and the nearest Number otherwise.
 //
 // This method is recursive. It will probably blow out the stack on objects
 // with extremely deep nesting.
 static Handle<Value>
-msgpack_to_v8(msgpack_object *mo) {
+msgpack_to_v8(msgpack_object *mo, MsgpackSources *ms, int flags) {
     switch (mo->type) {
     case MSGPACK_OBJECT_NIL:
         return Null();
@@ -210,10 +692,22 @@ msgpack_to_v8(msgpack_object *mo) {
             False();
 
     case MSGPACK_OBJECT_POSITIVE_INTEGER:
-        return Integer::NewFromUnsigned(mo->via.u64);
+        if (mo->via.u64 <= 0xffffffffULL) {
+            return Integer::NewFromUnsigned((uint32_t) mo->via.u64);
+        }
+        if (mo->via.u64 > (1ULL << 53) && (flags & UNPACK_INT64)) {
+            return int64_from_msgpack(mo->via.u64, false);
+        }
+        return Number::New((double) mo->via.u64);
 
     case MSGPACK_OBJECT_NEGATIVE_INTEGER:
-        return Integer::New(mo->via.i64);
+        if (mo->via.i64 >= -2147483648LL) {
+            return Integer::New((int32_t) mo->via.i64);
+        }
+        if (mo->via.i64 < -(1LL << 53) && (flags & UNPACK_INT64)) {
+            return int64_from_msgpack((uint64_t) mo->via.i64, true);
+        }
+        return Number::New((double) mo->via.i64);
 
     case MSGPACK_OBJECT_DOUBLE:
         return Number::New(mo->via.dec);
@@ -222,7 +716,7 @@ msgpack_to_v8(msgpack_object *mo) {
         Local<Array> a = Array::New(mo->via.array.size);
 
         for (uint32_t i = 0; i < mo->via.array.size; i++) {
-            a->Set(i, msgpack_to_v8(&mo->via.array.ptr[i]));
+            a->Set(i, msgpack_to_v8(&mo->via.array.ptr[i], ms, flags));
         }
 
         return a;
@@ -231,13 +725,22 @@ msgpack_to_v8(msgpack_object *mo) {
     case MSGPACK_OBJECT_RAW:
         return String::New(mo->via.raw.ptr, mo->via.raw.size);
 
+    case MSGPACK_OBJECT_BIN:
+        return ms->slice(mo->via.bin.ptr, mo->via.bin.size);
+
+    case MSGPACK_OBJECT_EXT:
+        if (mo->via.ext.type == MSGPACK_EXT_TIMESTAMP) {
+            return msgpack_to_date(&mo->via.ext);
+        }
+        throw MsgpackException("Encountered unknown MessagePack extension type");
+
     case MSGPACK_OBJECT_MAP: {
         Local<Object> o = Object::New();
 
         for (uint32_t i = 0; i < mo->via.map.size; i++) {
             o->Set(
-                msgpack_to_v8(&mo->via.map.ptr[i].key),
-                msgpack_to_v8(&mo->via.map.ptr[i].val)
+                msgpack_to_v8(&mo->via.map.ptr[i].key, ms, flags),
+                msgpack_to_v8(&mo->via.map.ptr[i].val, ms, flags)
             );
         }
 
@@ -249,16 +752,168 @@ msgpack_to_v8(msgpack_object *mo) {
     }
 }
 
-// var buf = msgpack.pack(obj[, obj ...]);
-//
-// Returns a Buffer object representing the serialized state of the provided
-// JavaScript object. If more arguments are provided, their serialized state
-// will be accumulated to the end of the previous value(s).
+// Whether the String `v' holds exactly the UTF-8 bytes of `raw'. Only short
+// strings are compared; longer ones are assumed to differ.
+static bool
+string_equals(Handle<Value> v, const msgpack_object_raw *raw) {
+    char buf[256];
+
+    Handle<String> str = v->ToString();
+    if (raw->size > sizeof(buf) || str->Utf8Length() != (int) raw->size) {
+        return false;
+    }
+
+    str->WriteUtf8(buf, raw->size);
+    return memcmp(buf, raw->ptr, raw->size) == 0;
+}
+
+// Whether `v' is an object that a map may be unpacked into
+static bool
+is_plain_object(Handle<Value> v) {
+    return v->IsObject() && !v->IsArray() && !v->IsDate() &&
+        !v->IsFunction() && !Buffer::HasInstance(v) &&
+        !msgpack_int64_template->HasInstance(v);
+}
+
+// Whether `key' is a property of `o' itself rather than of its prototypes
+static bool
+has_own(Handle<Object> o, Handle<Value> key) {
+    Local<Uint32> index = key->ToArrayIndex();
+    if (!index.IsEmpty()) {
+        return o->HasRealIndexedProperty(index->Value());
+    }
+
+    return o->HasRealNamedProperty(key->ToString());
+}
+
+// Like msgpack_to_v8(), but reuse `target' and the values inside it where
+// they have the same shape: arrays are overwritten in place and truncated
+// or extended, objects get their keys overwritten, added or deleted, and
+// equal strings and Numbers are kept. Anything else is created anew.
 //
-// Any number of objects can be provided as arguments, and all will be
-// serialized to the same bytestream, back-ty-back.
+// Map keys are looked up as symbols, which V8 interns, so unpacking a
+// message of the same shape as `target' allocates only for the strings
+// and Numbers that changed.
 static Handle<Value>
-pack(const Arguments &args) {
+msgpack_to_v8_into(msgpack_object *mo, Handle<Value> target,
+                   MsgpackSources *ms, int flags) {
+    if (target.IsEmpty()) {
+        return msgpack_to_v8(mo, ms, flags);
+    }
+
+    switch (mo->type) {
+    case MSGPACK_OBJECT_DOUBLE:
+        if (target->IsNumber() && target->NumberValue() == mo->via.dec) {
+            return target;
+        }
+        break;
+
+    case MSGPACK_OBJECT_RAW:
+        if (target->IsString() && string_equals(target, &mo->via.raw)) {
+            return target;
+        }
+        break;
+
+    case MSGPACK_OBJECT_ARRAY: {
+        if (!target->IsArray()) {
+            break;
+        }
+
+        Handle<Array> a = Handle<Array>::Cast(target);
+        uint32_t len = a->Length();
+
+        for (uint32_t i = 0; i < mo->via.array.size; i++) {
+            a->Set(i, msgpack_to_v8_into(
+                &mo->via.array.ptr[i],
+                (i < len) ? a->Get(i) : Handle<Value>(),
+                ms, flags
+            ));
+        }
+
+        if (len > mo->via.array.size) {
+            a->Set(msgpack_length_symbol,
+                   Integer::NewFromUnsigned(mo->via.array.size));
+        }
+
+        return a;
+    }
+
+    case MSGPACK_OBJECT_MAP: {
+        if (!is_plain_object(target)) {
+            break;
+        }
+
+        Handle<Object> o = target->ToObject();
+
+        // Only own properties are overwritten or deleted, those inherited
+        // from a prototype are left alone
+        Local<Array> names = o->GetPropertyNames();
+        uint32_t len = 0;
+        for (uint32_t i = 0, l = names->Length(); i < l; i++) {
+            if (has_own(o, names->Get(i))) {
+                len++;
+            }
+        }
+
+        // The distinct keys of the message, which may repeat some
+        std::set<std::string> keys;
+        bool added = false;
+
+        for (uint32_t i = 0; i < mo->via.map.size; i++) {
+            msgpack_object *k = &mo->via.map.ptr[i].key;
+            Handle<Value> key;
+            if (k->type == MSGPACK_OBJECT_RAW) {
+                key = String::NewSymbol(k->via.raw.ptr, k->via.raw.size);
+                keys.insert(std::string(k->via.raw.ptr, k->via.raw.size));
+            } else {
+                key = msgpack_to_v8(k, ms, flags);
+                String::Utf8Value name(key);
+                keys.insert(std::string(*name, name.length()));
+            }
+
+            Handle<Value> old;
+            if (has_own(o, key)) {
+                old = o->Get(key);
+            } else {
+                added = true;
+            }
+
+            o->Set(key, msgpack_to_v8_into(
+                &mo->via.map.ptr[i].val, old, ms, flags));
+        }
+
+        // Every key was there before and there were no others
+        if (!added && len == keys.size()) {
+            return o;
+        }
+
+        names = o->GetPropertyNames();
+        for (uint32_t i = 0, l = names->Length(); i < l; i++) {
+            Local<Value> name = names->Get(i);
+            String::Utf8Value n(name);
+            if (keys.find(std::string(*n, n.length())) == keys.end() &&
+                has_own(o, name)) {
+                o->Delete(name->ToString());
+            }
+        }
+
+        return o;
+    }
+
+    default:
+        break;
+    }
+
+    return msgpack_to_v8(mo, ms, flags);
+}
+
+// Pack the arguments back-to-back. Strings are packed as str, Buffers as bin
+// and Dates as timestamps; in PACK_COMPAT mode strings and Buffers are raw
+// and Dates are numbers of milliseconds. Numbers under the map keys in
+// `pins' take their widest encoding.
+static Handle<Value>
+pack_args(const Arguments &args, int first, int flags,
+          const std::set<std::string> *pins = NULL) {
     HandleScope scope;
 
     msgpack_packer pk;
@@ -268,16 +923,16 @@ pack(const Arguments &args) {
 
     msgpack_packer_init(&pk, &sb._sbuf, msgpack_sbuffer_write);
 
-    for (int i = 0; i < args.Length(); i++) {
+    for (int i = first; i < args.Length(); i++) {
         msgpack_object mo;
 
         try {
-            v8_to_msgpack(args[0], &mo, &mz._mz, &mc);
+            v8_to_msgpack(args[i], &mo, &mz._mz, &mc, flags, pins);
         } catch (MsgpackException e) {
             return ThrowException(e.getThrownException());
         }
 
-        if (msgpack_pack_object(&pk, mo)) {
+        if (pack_msgpack_object(&pk, &mo, flags)) {
             return ThrowException(Exception::Error(
                 String::New("Error serializaing object")));
         }
@@ -288,30 +943,855 @@ pack(const Arguments &args) {
     return scope.Close(bp->handle_);
 }
 
-// var o = msgpack.unpack(buf);
+// var buf = msgpack.pack(obj[, obj ...]);
 //
-// Return the JavaScript object resulting from unpacking the contents of the
-// specified buffer. If the buffer does not contain a complete object, the
-// undefined value is returned.
+// Returns a Buffer object representing the serialized state of the provided
+// JavaScript object. If more arguments are provided, their serialized state
+// will be accumulated to the end of the previous value(s).
+//
+// Any number of objects can be provided as arguments, and all will be
+// serialized to the same bytestream, back-ty-back.
 static Handle<Value>
-unpack(const Arguments &args) {
-    static Persistent<String> msgpack_bytes_remaining_symbol = 
-        NODE_PSYMBOL("bytes_remaining");
+pack(const Arguments &args) {
+    return pack_args(args, 0, 0);
+}
+
+// var buf = msgpack.packCompat(obj[, obj ...]);
+//
+// Like pack(), but readable by peers of the old MessagePack spec, which
+// know neither str 8, bin nor ext. Buffers are packed as raw and so unpack
+// as strings; Dates are packed as numbers of milliseconds.
+static Handle<Value>
+pack_compat(const Arguments &args) {
+    return pack_args(args, 0, PACK_COMPAT);
+}
+
+// Build the v8_to_msgpack() flags from an options object:
+//
+//   compat    pack like packCompat()
+//   float32   pack non-integral Numbers that a float holds exactly in 5
+//             bytes instead of 9; integral ones already take the smallest
+//             integer form
+//   cache     keep the encoding of deeply frozen arrays and objects on them
+//             and copy it into the output when they are packed again, here
+//             or nested in another value
+//
+// packWith() also takes `pin', see v8_to_pack_pins().
+static int
+v8_to_pack_flags(Handle<Value> v) {
+    int flags = 0;
+    if (!v->IsObject()) {
+        return flags;
+    }
+
+    Handle<Object> opts = v->ToObject();
+    if (opts->Get(String::NewSymbol("compat"))->BooleanValue()) {
+        flags |= PACK_COMPAT;
+    }
+    if (opts->Get(String::NewSymbol("float32"))->BooleanValue()) {
+        flags |= PACK_FLOAT32;
+    }
+    if (opts->Get(String::NewSymbol("cache"))->BooleanValue()) {
+        flags |= PACK_CACHE;
+    }
+
+    return flags;
+}
+
+// Read the `pin' option, an Array of map keys whose numbers are packed in
+// their widest encoding so that patch() can always overwrite them:
+//
+//   {pin: ['hits', 'updated']}
+//
+// Returns whether there are any.
+static bool
+v8_to_pack_pins(Handle<Value> v, std::set<std::string> *pins) {
+    if (!v->IsObject()) {
+        return false;
+    }
+
+    Local<Value> pin = v->ToObject()->Get(String::NewSymbol("pin"));
+    if (!pin->IsArray()) {
+        return false;
+    }
+
+    Handle<Array> a = Handle<Array>::Cast(pin);
+    for (uint32_t i = 0, l = a->Length(); i < l; i++) {
+        String::Utf8Value key(a->Get(i));
+        pins->insert(std::string(*key, key.length()));
+    }
+
+    return !pins->empty();
+}
+
+// var buf = msgpack.packWith({compat: true, float32: true}, obj[, obj ...]);
+//
+// Like pack(), with the options of v8_to_pack_flags() and
+// v8_to_pack_pins().
+static Handle<Value>
+pack_with(const Arguments &args) {
+    int flags = v8_to_pack_flags(args[0]);
+
+    std::set<std::string> pins;
+    if (!v8_to_pack_pins(args[0], &pins)) {
+        return pack_args(args, 1, flags);
+    }
+
+    // The cached encodings don't know about pins
+    return pack_args(args, 1, flags & ~PACK_CACHE, &pins);
+}
+
+#define MSGPACK_ENCODER_CHUNK_SIZE (64 * 1024)
+
+// var enc = new msgpack.Encoder(stream[, {chunkSize: 65536, ...}]);
+// enc.arrayHeader(3);
+// enc.value(obj);
+// ...
+// enc.flush();
+//
+// Packs a value piece by piece into fixed-size Buffers that are written to
+// `stream' as they fill up, so that values of any size can be produced in
+// bounded memory. The options are those of packWith() plus `chunkSize'.
+//
+// Every method returns false if the stream asked to wait for 'drain'
+// while it ran, like stream.write() does.
+class MsgpackEncoder : public ObjectWrap {
+    public:
+        MsgpackEncoder(Handle<Object> stream, size_t size, int flags) :
+            _stream(Persistent<Object>::New(stream)),
+            _data(NULL), _size(size), _used(0), _ok(true), _flags(flags) {
+            msgpack_packer_init(&_pk, this, write);
+        }
+
+        ~MsgpackEncoder() {
+            _chunk.Dispose();
+            _stream.Dispose();
+        }
+
+        static Handle<Value> New(const Arguments &args) {
+            HandleScope scope;
+
+            if (!args[0]->IsObject()) {
+                return ThrowException(Exception::TypeError(
+                    String::New("First argument must be a stream")));
+            }
+
+            size_t size = MSGPACK_ENCODER_CHUNK_SIZE;
+            if (args[1]->IsObject()) {
+                Local<Value> v = args[1]->ToObject()->Get(
+                    String::NewSymbol("chunkSize"));
+                if (v->IsUint32() && v->Uint32Value() > 0) {
+                    size = v->Uint32Value();
+                }
+            }
+
+            MsgpackEncoder *e = new MsgpackEncoder(
+                args[0]->ToObject(), size, v8_to_pack_flags(args[1]));
+            e->Wrap(args.This());
+
+            return args.This();
+        }
+
+        // enc.arrayHeader(n)
+        //
+        // Start an array of `n' elements; the next `n' values are in it.
+        static Handle<Value> ArrayHeader(const Arguments &args) {
+            MsgpackEncoder *e = ObjectWrap::Unwrap<MsgpackEncoder>(args.This());
+            e->_ok = true;
+            msgpack_pack_array(&e->_pk, args[0]->Uint32Value());
+            return Boolean::New(e->_ok);
+        }
+
+        // enc.mapHeader(n)
+        //
+        // Start a map of `n' pairs; the next 2 * `n' values are its keys
+        // and values.
+        static Handle<Value> MapHeader(const Arguments &args) {
+            MsgpackEncoder *e = ObjectWrap::Unwrap<MsgpackEncoder>(args.This());
+            e->_ok = true;
+            msgpack_pack_map(&e->_pk, args[0]->Uint32Value());
+            return Boolean::New(e->_ok);
+        }
+
+        // enc.value(v)
+        //
+        // Pack a whole value, as pack() does.
+        static Handle<Value> PackValue(const Arguments &args) {
+            HandleScope scope;
+
+            MsgpackEncoder *e = ObjectWrap::Unwrap<MsgpackEncoder>(args.This());
+            e->_ok = true;
+
+            MsgpackZone mz;
+            MsgpackCycle mc;
+            msgpack_object mo;
+
+            try {
+                v8_to_msgpack(args[0], &mo, &mz._mz, &mc, e->_flags);
+            } catch (MsgpackException ex) {
+                return ThrowException(ex.getThrownException());
+            }
+
+            if (pack_msgpack_object(&e->_pk, &mo, e->_flags)) {
+                return ThrowException(Exception::Error(
+                    String::New("Error serializaing object")));
+            }
+
+            return scope.Close(Boolean::New(e->_ok));
+        }
+
+        // enc.raw(buf)
+        //
+        // Append bytes that are already packed. A Buffer at least as large
+        // as a chunk is written as it is rather than copied.
+        static Handle<Value> Raw(const Arguments &args) {
+            HandleScope scope;
+
+            if (!Buffer::HasInstance(args[0])) {
+                return ThrowException(Exception::TypeError(
+                    String::New("First argument must be a Buffer")));
+            }
+
+            MsgpackEncoder *e = ObjectWrap::Unwrap<MsgpackEncoder>(args.This());
+            e->_ok = true;
+
+            Handle<Object> buf = args[0]->ToObject();
+            if (Buffer::Length(buf) >= e->_size) {
+                e->flush();
+                e->emit(buf);
+            } else {
+                write(e, Buffer::Data(buf), Buffer::Length(buf));
+            }
+
+            return scope.Close(Boolean::New(e->_ok));
+        }
+
+        // enc.flush()
+        //
+        // Write what is in the current chunk, e.g. at the end of a value.
+        static Handle<Value> Flush(const Arguments &args) {
+            MsgpackEncoder *e = ObjectWrap::Unwrap<MsgpackEncoder>(args.This());
+            e->_ok = true;
+            e->flush();
+            return Boolean::New(e->_ok);
+        }
+
+    private:
+        // msgpack_packer callback: copy into the chunk, writing each one to
+        // the stream as soon as it is full
+        static int write(void *data, const char *buf, unsigned int len) {
+            MsgpackEncoder *e = (MsgpackEncoder*) data;
+
+            while (len > 0) {
+                if (e->_data == NULL) {
+                    Buffer *bp = Buffer::New(e->_size);
+                    e->_chunk = Persistent<Object>::New(bp->handle_);
+                    e->_data = Buffer::Data(e->_chunk);
+                }
+
+                size_t n = e->_size - e->_used;
+                if (n > len) {
+                    n = len;
+                }
+
+                memcpy(e->_data + e->_used, buf, n);
+                e->_used += n;
+                buf += n;
+                len -= n;
+
+                if (e->_used == e->_size) {
+                    e->flush();
+                }
+            }
+
+            return 0;
+        }
+
+        // Write the current chunk, or as much of it as is used
+        void flush() {
+            if (_used == 0) {
+                return;
+            }
+
+            HandleScope scope;
+
+            Local<Value> chunk = Local<Value>::New(_chunk);
+            if (_used < _size) {
+                Handle<Value> argv[2] = {
+                    Integer::New(0),
+                    Integer::NewFromUnsigned(_used)
+                };
+                Handle<Function> f = Handle<Function>::Cast(
+                    _chunk->Get(msgpack_slice_symbol));
+                chunk = f->Call(_chunk, 2, argv);
+            }
+
+            _chunk.Dispose();
+            _chunk.Clear();
+            _data = NULL;
+            _used = 0;
+
+            emit(chunk);
+        }
+
+        // stream.write(buf)
+        void emit(Handle<Value> buf) {
+            HandleScope scope;
+
+            Handle<Function> f = Handle<Function>::Cast(
+                _stream->Get(String::NewSymbol("write")));
+            if (!f->Call(_stream, 1, &buf)->BooleanValue()) {
+                _ok = false;
+            }
+        }
+
+        Persistent<Object> _stream;
+        Persistent<Object> _chunk;
+        char *_data;
+        size_t _size;
+        size_t _used;
+        bool _ok;
+        int _flags;
+        msgpack_packer _pk;
+};
+
+// var o = msgpack.clone(obj);
+//
+// A deep copy of `obj', the same as msgpack.unpack(msgpack.pack(obj)) but
+// converted through the MessagePack object model without producing or
+// parsing any bytes. Buffers are copied, and Int64 objects beyond 2^53
+// stay Int64 objects. Circular references throw like they do in pack().
+static Handle<Value>
+clone(const Arguments &args) {
+    HandleScope scope;
+
+    MsgpackZone mz;
+    MsgpackCycle mc;
+    MsgpackSources ms;
+    msgpack_object mo;
+
+    try {
+        v8_to_msgpack(args[0], &mo, &mz._mz, &mc, 0);
+
+        // No sources, so bin objects are copied out of the original Buffers
+        return scope.Close(msgpack_to_v8(&mo, &ms, UNPACK_INT64));
+    } catch (MsgpackException e) {
+        return ThrowException(e.getThrownException());
+    }
+}
+
+static Persistent<String> msgpack_bytes_remaining_symbol;
+
+// Set one of the limits from a property of the options object, if present
+static void
+v8_to_limit(Handle<Object> opts, const char *name, size_t *limit) {
+    Local<Value> v = opts->Get(String::NewSymbol(name));
+    if (v->IsUint32()) {
+        *limit = v->Uint32Value();
+    }
+}
+
+// Build the limits for untrusted input from an options object:
+//
+//   {maxDepth: 8, maxArrayLength: 1000, maxMapSize: 100,
+//    maxRawLength: 65536, maxBytes: 1048576}
+//
+// A message exceeding any of them fails to unpack as soon as the offending
+// header is read, before anything is allocated for it.
+static void
+v8_to_unpack_limit(Handle<Value> v, msgpack_unpack_limit *limit) {
+    msgpack_unpack_limit_init(limit);
+    if (!v->IsObject()) {
+        return;
+    }
+
+    Handle<Object> opts = v->ToObject();
+    v8_to_limit(opts, "maxDepth", &limit->depth);
+    v8_to_limit(opts, "maxArrayLength", &limit->array);
+    v8_to_limit(opts, "maxMapSize", &limit->map);
+    v8_to_limit(opts, "maxRawLength", &limit->raw);
+    v8_to_limit(opts, "maxBytes", &limit->total);
+}
+
+// Build the msgpack_to_v8() flags from the same options object:
+//
+//   {int64: true}
+static int
+v8_to_unpack_flags(Handle<Value> v) {
+    int flags = 0;
+    if (!v->IsObject()) {
+        return flags;
+    }
+
+    Handle<Object> opts = v->ToObject();
+    if (opts->Get(String::NewSymbol("int64"))->BooleanValue()) {
+        flags |= UNPACK_INT64;
+    }
+
+    return flags;
+}
+
+// Unpack the first object from a rope, an Array of Buffers holding
+// consecutive pieces of the stream. Each Buffer is parsed in place; only a
+// header or raw that straddles two Buffers is copied into the unpacker's
+// scratch buffer, so a large message spanning many reads is never
+// concatenated.
+static Handle<Value>
+unpack_rope(Handle<Array> rope, const msgpack_unpack_limit *limit, int flags,
+            Handle<Value> target) {
+    MsgpackUnpacker mu;
+    MsgpackSources ms;
+    size_t total = 0;
+    int ret = 0;
+
+    msgpack_unpacker_set_limit(&mu._mu, limit);
+
+    for (uint32_t i = 0, l = rope->Length(); i < l; i++) {
+        Local<Value> b = rope->Get(i);
+        if (!Buffer::HasInstance(b)) {
+            return ThrowException(Exception::TypeError(
+                String::New("First argument must be a Buffer or an Array of Buffers")));
+        }
+
+        Handle<Object> buf = b->ToObject();
+        total += Buffer::Length(buf);
+        ms.add(buf);
+
+        // Keep adding up the rest of the rope for bytes_remaining
+        if (ret != 0) {
+            continue;
+        }
+
+        if (!msgpack_unpacker_feed_region(&mu._mu,
+                Buffer::Data(buf), Buffer::Length(buf), NULL, NULL)) {
+            return ThrowException(Exception::Error(
+                String::New("Out of memory de-serializing object")));
+        }
+
+        ret = msgpack_unpacker_execute(&mu._mu);
+        if (ret < 0) {
+            return ThrowException(Exception::Error(
+                String::New("Error de-serializing object")));
+        }
+    }
+
+    if (ret == 0) {
+        return Undefined();
+    }
+
+    msgpack_object mo = msgpack_unpacker_data(&mu._mu);
+    try {
+        msgpack_unpack_template->GetFunction()->Set(
+            msgpack_bytes_remaining_symbol,
+            Integer::New(total - msgpack_unpacker_parsed_size(&mu._mu))
+        );
+        return msgpack_to_v8_into(&mo, target, &ms, flags);
+    } catch (MsgpackException e) {
+        return ThrowException(e.getThrownException());
+    }
+}
+
+// Unpacks one value after another from a stream whose Buffers are handed
+// over as they arrive. The state of a value still incomplete is kept from
+// one call to the next, along with the Buffers it was parsed from, so each
+// byte is parsed once however many pieces the value comes in; see Reader
+// in lib/msgpack.js.
+//
+// var u = new mpBindings.RopeUnpacker(opts);
+// var v = u.execute(rope);     // undefined until the value is complete
+// u.bytes_remaining;           // bytes at the end of `rope' after it
+//
+// `rope' is an Array of the Buffers that arrived since the last call. When
+// the value is incomplete, all of them are consumed. `opts' are limits and
+// flags as for unpack().
+class MsgpackRopeUnpacker : public ObjectWrap {
+    public:
+        MsgpackRopeUnpacker(const msgpack_unpack_limit &limit, int flags) :
+            _mu(NULL), _limit(limit), _flags(flags) {
+        }
+
+        ~MsgpackRopeUnpacker() {
+            reset();
+        }
+
+        static Handle<Value> New(const Arguments &args) {
+            HandleScope scope;
+
+            msgpack_unpack_limit limit;
+            v8_to_unpack_limit(args[0], &limit);
+
+            MsgpackRopeUnpacker *u = new MsgpackRopeUnpacker(
+                limit, v8_to_unpack_flags(args[0]));
+            u->Wrap(args.This());
+
+            return args.This();
+        }
+
+        static Handle<Value> Execute(const Arguments &args) {
+            HandleScope scope;
+
+            MsgpackRopeUnpacker *u =
+                ObjectWrap::Unwrap<MsgpackRopeUnpacker>(args.This());
+
+            if (!args[0]->IsArray()) {
+                return ThrowException(Exception::TypeError(
+                    String::New("First argument must be an Array of Buffers")));
+            }
+
+            Handle<Array> rope = Handle<Array>::Cast(args[0]);
+            uint32_t i = 0, l = rope->Length();
+            size_t remaining = 0;
+            int ret = 0;
+
+            if (u->_mu == NULL) {
+                u->_mu = new MsgpackUnpacker();
+                msgpack_unpacker_set_limit(&u->_mu->_mu, &u->_limit);
+            }
+
+            while (i < l && ret == 0) {
+                Local<Value> b = rope->Get(i++);
+                if (!Buffer::HasInstance(b)) {
+                    u->reset();
+                    return ThrowException(Exception::TypeError(
+                        String::New("First argument must be an Array of Buffers")));
+                }
+
+                // Raws and bins may point into it until the value is done
+                Handle<Object> buf = b->ToObject();
+                u->_bufs.push_back(Persistent<Object>::New(buf));
+
+                if (!msgpack_unpacker_feed_region(&u->_mu->_mu,
+                        Buffer::Data(buf), Buffer::Length(buf), NULL, NULL)) {
+                    u->reset();
+                    return ThrowException(Exception::Error(
+                        String::New("Out of memory de-serializing object")));
+                }
+
+                ret = msgpack_unpacker_execute(&u->_mu->_mu);
+                if (ret < 0) {
+                    u->reset();
+                    return ThrowException(Exception::Error(
+                        String::New("Error de-serializing object")));
+                }
+                if (ret > 0) {
+                    remaining = u->_mu->_mu.region_size - u->_mu->_mu.region_off;
+                }
+            }
+
+            if (ret == 0) {
+                return scope.Close(Undefined());
+            }
+
+            for (; i < l; i++) {
+                Local<Value> b = rope->Get(i);
+                if (Buffer::HasInstance(b)) {
+                    remaining += Buffer::Length(b->ToObject());
+                }
+            }
+
+            MsgpackSources ms;
+            for (std::list< Persistent<Object> >::iterator iter = u->_bufs.begin();
+                 iter != u->_bufs.end();
+                 iter++) {
+                ms.add(*iter);
+            }
+
+            msgpack_object mo = msgpack_unpacker_data(&u->_mu->_mu);
+            Local<Value> v;
+            try {
+                v = Local<Value>::New(msgpack_to_v8(&mo, &ms, u->_flags));
+            } catch (MsgpackException e) {
+                u->reset();
+                return ThrowException(e.getThrownException());
+            }
+
+            u->reset();
+            args.This()->Set(msgpack_bytes_remaining_symbol,
+                             Integer::NewFromUnsigned(remaining));
+
+            return scope.Close(v);
+        }
+
+        // Whether a value has been started but isn't complete yet
+        static Handle<Value> Partial(const Arguments &args) {
+            MsgpackRopeUnpacker *u =
+                ObjectWrap::Unwrap<MsgpackRopeUnpacker>(args.This());
+            return Boolean::New(!u->_bufs.empty());
+        }
+
+    private:
+        // Drop the value in progress, if any
+        void reset() {
+            delete _mu;
+            _mu = NULL;
+
+            for (std::list< Persistent<Object> >::iterator iter = _bufs.begin();
+                 iter != _bufs.end();
+                 iter++) {
+                iter->Dispose();
+            }
+            _bufs.clear();
+        }
+
+        MsgpackUnpacker *_mu;
+        std::list< Persistent<Object> > _bufs;
+        msgpack_unpack_limit _limit;
+        int _flags;
+};
+
+// Whether a message can be kept in a MsgpackUnpackCache: Buffers and Dates
+// could be changed by whoever gets them, even when frozen.
+static bool
+unpack_cacheable(msgpack_object *mo) {
+    switch (mo->type) {
+    case MSGPACK_OBJECT_BIN:
+    case MSGPACK_OBJECT_EXT:
+        return false;
+
+    case MSGPACK_OBJECT_ARRAY:
+        for (uint32_t i = 0; i < mo->via.array.size; i++) {
+            if (!unpack_cacheable(&mo->via.array.ptr[i])) {
+                return false;
+            }
+        }
+        return true;
+
+    case MSGPACK_OBJECT_MAP:
+        for (uint32_t i = 0; i < mo->via.map.size; i++) {
+            if (!unpack_cacheable(&mo->via.map.ptr[i].key) ||
+                !unpack_cacheable(&mo->via.map.ptr[i].val)) {
+                return false;
+            }
+        }
+        return true;
+
+    default:
+        return true;
+    }
+}
+
+// Object.freeze() `v' and everything in it
+static void
+deep_freeze(Handle<Value> v) {
+    if (!v->IsObject()) {
+        return;
+    }
+
+    Handle<Object> o = v->ToObject();
+    Local<Array> names = o->GetPropertyNames();
+    for (uint32_t i = 0, l = names->Length(); i < l; i++) {
+        deep_freeze(o->Get(names->Get(i)));
+    }
+
+    msgpack_freeze->Call(Context::GetCurrent()->Global(), 1, &v);
+}
+
+// A hash of `len' bytes, 8 at a time
+static uint64_t
+hash_bytes(const char *p, size_t len) {
+    uint64_t h = len;
+
+    for (; len >= 8; p += 8, len -= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (((h << 5) | (h >> 59)) ^ w) * 0x517cc1b727220a95ULL;
+    }
+    for (; len > 0; p++, len--) {
+        h = (((h << 5) | (h >> 59)) ^ (uint8_t) *p) * 0x517cc1b727220a95ULL;
+    }
+
+    return h;
+}
+
+// var cache = new msgpack.UnpackCache(maxEntries);
+// var o = msgpack.unpack(buf, {cache: cache});
+//
+// A bounded LRU of decoded messages keyed by their bytes, for payloads that
+// are received over and over again. A message is still parsed to find where
+// it ends, but on a hit the value decoded the first time is returned
+// instead of building a new one, so it is shared and deeply frozen.
+// Messages holding bin or ext values are decoded as usual and not cached.
+class MsgpackUnpackCache : public ObjectWrap {
+    public:
+        MsgpackUnpackCache(size_t max) :
+            _max(max), _hits(0), _misses(0), _evictions(0) {
+        }
+
+        ~MsgpackUnpackCache() {
+            clear();
+        }
+
+        // The value of the message in the `len' bytes at `data', which
+        // parsed to `mo'
+        Handle<Value> unpack(const char *data, size_t len, msgpack_object *mo,
+                             int flags) {
+            uint64_t hash = hash_bytes(data, len);
+
+            std::pair<Index::iterator, Index::iterator> r =
+                _index.equal_range(hash);
+            for (Index::iterator iter = r.first; iter != r.second; iter++) {
+                Entry &e = *iter->second;
+                if (e.flags == flags && e.bytes.size() == len &&
+                    memcmp(e.bytes.data(), data, len) == 0) {
+                    _lru.splice(_lru.begin(), _lru, iter->second);
+                    _hits++;
+                    return e.value;
+                }
+            }
+
+            _misses++;
+
+            MsgpackSources ms;
+            Handle<Value> v = msgpack_to_v8(mo, &ms, flags);
+            deep_freeze(v);
+
+            if (_max == 0) {
+                return v;
+            }
+            if (_lru.size() >= _max) {
+                evict();
+            }
+
+            _lru.push_front(Entry());
+            Entry &e = _lru.front();
+            e.hash = hash;
+            e.flags = flags;
+            e.bytes.assign(data, len);
+            e.value = Persistent<Value>::New(v);
+            _index.insert(std::make_pair(hash, _lru.begin()));
+
+            return v;
+        }
+
+        void clear() {
+            while (!_lru.empty()) {
+                _lru.back().value.Dispose();
+                _lru.pop_back();
+            }
+            _index.clear();
+        }
+
+        static Handle<Value> New(const Arguments &args) {
+            HandleScope scope;
+
+            MsgpackUnpackCache *c = new MsgpackUnpackCache(
+                args[0]->IsUint32() ? args[0]->Uint32Value() : 1024);
+            c->Wrap(args.This());
+
+            return args.This();
+        }
+
+        // cache.stats()
+        //
+        // {hits: 10, misses: 2, evictions: 0, entries: 2}
+        static Handle<Value> Stats(const Arguments &args) {
+            HandleScope scope;
+
+            MsgpackUnpackCache *c =
+                ObjectWrap::Unwrap<MsgpackUnpackCache>(args.This());
+
+            Local<Object> o = Object::New();
+            o->Set(String::NewSymbol("hits"), Number::New(c->_hits));
+            o->Set(String::NewSymbol("misses"), Number::New(c->_misses));
+            o->Set(String::NewSymbol("evictions"),
+                   Number::New(c->_evictions));
+            o->Set(String::NewSymbol("entries"),
+                   Integer::NewFromUnsigned(c->_lru.size()));
+
+            return scope.Close(o);
+        }
+
+        // cache.clear()
+        static Handle<Value> Clear(const Arguments &args) {
+            ObjectWrap::Unwrap<MsgpackUnpackCache>(args.This())->clear();
+            return Undefined();
+        }
+
+    private:
+        struct Entry {
+            uint64_t hash;
+            int flags;
+            std::string bytes;
+            Persistent<Value> value;
+        };
+
+        typedef std::list<Entry> Lru;
+        typedef std::multimap<uint64_t, Lru::iterator> Index;
+
+        void evict() {
+            Entry &e = _lru.back();
+
+            std::pair<Index::iterator, Index::iterator> r =
+                _index.equal_range(e.hash);
+            for (Index::iterator iter = r.first; iter != r.second; iter++) {
+                if (&*iter->second == &e) {
+                    _index.erase(iter);
+                    break;
+                }
+            }
+
+            e.value.Dispose();
+            _lru.pop_back();
+            _evictions++;
+        }
+
+        size_t _max;
+        Lru _lru;           // most recently used first
+        Index _index;
+        double _hits;
+        double _misses;
+        double _evictions;
+};
+
+static Persistent<FunctionTemplate> msgpack_unpack_cache_template;
+
+// The `cache' of an options object, if it is an UnpackCache
+static MsgpackUnpackCache *
+v8_to_unpack_cache(Handle<Value> v) {
+    if (!v->IsObject()) {
+        return NULL;
+    }
+
+    Local<Value> c = v->ToObject()->Get(String::NewSymbol("cache"));
+    if (!msgpack_unpack_cache_template->HasInstance(c)) {
+        return NULL;
+    }
+
+    return ObjectWrap::Unwrap<MsgpackUnpackCache>(c->ToObject());
+}
 
+// Unpack the first object from `data', a Buffer or a rope, with the limits
+// and flags from `opts' and into `target' unless it is empty. A Buffer is
+// looked up in the UnpackCache of `opts', if any and without `target'.
+static Handle<Value>
+unpack_data(Handle<Value> data, Handle<Value> opts, Handle<Value> target) {
     HandleScope scope;
 
-    if (args.Length() < 0 || !Buffer::HasInstance(args[0])) {
+    msgpack_unpack_limit limit;
+    v8_to_unpack_limit(opts, &limit);
+    int flags = v8_to_unpack_flags(opts);
+
+    if (data->IsArray()) {
+        return scope.Close(
+            unpack_rope(Handle<Array>::Cast(data), &limit, flags, target));
+    }
+
+    if (!Buffer::HasInstance(data)) {
         return ThrowException(Exception::TypeError(
             String::New("First argument must be a Buffer")));
     }
 
-    Handle<Object> buf = args[0]->ToObject();
+    Handle<Object> buf = data->ToObject();
+
+    MsgpackSources ms;
+    ms.add(buf);
 
     MsgpackZone mz;
     msgpack_object mo;
     size_t off = 0;
 
-    switch (msgpack_unpack(Buffer::Data(buf), Buffer::Length(buf), &off, &mz._mz, &mo)) {
+    switch (msgpack_unpack_limited(Buffer::Data(buf), Buffer::Length(buf), &off,
+                &mz._mz, &mo, &limit)) {
     case MSGPACK_UNPACK_EXTRA_BYTES:
     case MSGPACK_UNPACK_SUCCESS:
         try {
@@ -319,7 +1799,14 @@ unpack(const Arguments &args) {
                 msgpack_bytes_remaining_symbol,
                 Integer::New(Buffer::Length(buf) - off)
             );
-            return scope.Close(msgpack_to_v8(&mo));
+
+            MsgpackUnpackCache *cache = v8_to_unpack_cache(opts);
+            if (cache && target.IsEmpty() && unpack_cacheable(&mo)) {
+                return scope.Close(
+                    cache->unpack(Buffer::Data(buf), off, &mo, flags));
+            }
+
+            return scope.Close(msgpack_to_v8_into(&mo, target, &ms, flags));
         } catch (MsgpackException e) {
             return ThrowException(e.getThrownException());
         }
@@ -333,11 +1820,716 @@ unpack(const Arguments &args) {
     }
 }
 
+// var o = msgpack.unpack(buf);
+// var o = msgpack.unpack([buf, buf, ...]);
+// var o = msgpack.unpack(buf, {maxBytes: 1048576, ...});
+//
+// Return the JavaScript object resulting from unpacking the contents of the
+// specified buffer. If the buffer does not contain a complete object, the
+// undefined value is returned.
+//
+// An Array of Buffers is unpacked as if the Buffers were concatenated, but
+// without copying them.
+//
+// The optional second argument limits what the message may claim, see
+// v8_to_unpack_limit(), and selects how integers are unpacked, see
+// v8_to_unpack_flags().
+static Handle<Value>
+unpack(const Arguments &args) {
+    return unpack_data(args[0], args[1], Handle<Value>());
+}
+
+// var o = msgpack.unpackInto(buf, target[, opts]);
+//
+// Like unpack(), but reuse the objects and arrays of `target', typically
+// the result of unpacking the previous message of the same shape; see
+// msgpack_to_v8_into(). Returns `target' if the message has its shape,
+// and a new object otherwise.
+static Handle<Value>
+unpack_into(const Arguments &args) {
+    return unpack_data(args[0], args[2], args[1]);
+}
+
+// The object at `path' in `mo', or NULL. Strings in `path' select the
+// value of a map key, and integers an element of an array or the value of
+// an integer map key.
+static msgpack_object *
+path_lookup(msgpack_object *mo, Handle<Array> path, msgpack_zone *mz) {
+    for (uint32_t i = 0, l = path->Length(); i < l; i++) {
+        Local<Value> k = path->Get(i);
+
+        if (mo->type == MSGPACK_OBJECT_ARRAY && k->IsUint32()) {
+            uint32_t n = k->Uint32Value();
+            if (n >= mo->via.array.size) {
+                return NULL;
+            }
+            mo = &mo->via.array.ptr[n];
+            continue;
+        }
+
+        if (mo->type != MSGPACK_OBJECT_MAP) {
+            return NULL;
+        }
+
+        msgpack_object key;
+        MsgpackCycle mc;
+        v8_to_msgpack(k, &key, mz, &mc, 0);
+
+        msgpack_object *found = NULL;
+        for (uint32_t j = 0; j < mo->via.map.size; j++) {
+            if (msgpack_object_equal(mo->via.map.ptr[j].key, key)) {
+                found = &mo->via.map.ptr[j].val;
+                break;
+            }
+        }
+        if (found == NULL) {
+            return NULL;
+        }
+        mo = found;
+    }
+
+    return mo;
+}
+
+static Persistent<String> msgpack_bytes_needed_symbol;
+
+static size_t
+message_bound(const char *begin, const char *end);
+
+// var r = msgpack.peek(buf, path[, opts]);
+//
+// Find the first message in `buf' and the value at `path' inside it, an
+// Array of map keys and array indexes, e.g. ['header', 'route']. Returns
+// [length of the message in bytes, value], with an undefined value if
+// there is nothing at `path', or undefined if `buf' holds no complete
+// message. Only the value is converted to JavaScript, so frames can be
+// routed on a field and forwarded as they are. `opts' are limits as for
+// unpack().
+//
+// When the message is incomplete, peek.bytes_needed is set to the least
+// number of bytes it may take, as far as the headers in `buf' tell, so
+// that callers can wait for that many before trying again.
+static Handle<Value>
+peek(const Arguments &args) {
+    HandleScope scope;
+
+    if (!Buffer::HasInstance(args[0])) {
+        return ThrowException(Exception::TypeError(
+            String::New("First argument must be a Buffer")));
+    }
+    if (!args[1]->IsArray()) {
+        return ThrowException(Exception::TypeError(
+            String::New("Second argument must be an Array")));
+    }
+
+    Handle<Object> buf = args[0]->ToObject();
+    Handle<Array> path = Handle<Array>::Cast(args[1]);
+
+    msgpack_unpack_limit limit;
+    v8_to_unpack_limit(args[2], &limit);
+    int flags = v8_to_unpack_flags(args[2]);
+
+    MsgpackSources ms;
+    ms.add(buf);
+
+    MsgpackZone mz;
+    msgpack_object mo;
+    size_t off = 0;
+
+    switch (msgpack_unpack_limited(Buffer::Data(buf), Buffer::Length(buf), &off,
+                &mz._mz, &mo, &limit)) {
+    case MSGPACK_UNPACK_EXTRA_BYTES:
+    case MSGPACK_UNPACK_SUCCESS:
+        try {
+            msgpack_object *field = path_lookup(&mo, path, &mz._mz);
+
+            Local<Array> r = Array::New(2);
+            r->Set(0, Integer::NewFromUnsigned(off));
+            r->Set(1, field ?
+                msgpack_to_v8(field, &ms, flags) :
+                Handle<Value>(Undefined()));
+            return scope.Close(r);
+        } catch (MsgpackException e) {
+            return ThrowException(e.getThrownException());
+        }
+
+    case MSGPACK_UNPACK_CONTINUE:
+        args.Callee()->Set(
+            msgpack_bytes_needed_symbol,
+            Integer::NewFromUnsigned(message_bound(
+                Buffer::Data(buf), Buffer::Data(buf) + Buffer::Length(buf)))
+        );
+        return scope.Close(Undefined());
+
+    default:
+        return ThrowException(Exception::Error(
+            String::New("Error de-serializing object")));
+    }
+}
+
+// The size of the header of the object at `p' and of the bytes following
+// it, and the number of objects following as its elements, or its keys and
+// values. Returns false if `p' is not a valid header or is cut short.
+static bool
+header_at(const char *p, const char *end, size_t *hdr, size_t *body,
+          uint64_t *children) {
+    if (p >= end) {
+        return false;
+    }
+
+    unsigned char b = *p;
+    size_t avail = end - p;
+
+    *hdr = 1;
+    *body = 0;
+    *children = 0;
+
+    if (b <= 0x7f || b >= 0xe0 || b == 0xc0 || b == 0xc2 || b == 0xc3) {
+        return true;
+    }
+    if (b <= 0x8f) {
+        *children = 2 * (b & 0x0f);
+        return true;
+    }
+    if (b <= 0x9f) {
+        *children = b & 0x0f;
+        return true;
+    }
+    if (b <= 0xbf) {
+        *body = b & 0x1f;
+        return *hdr + *body <= avail;
+    }
+
+    switch (b) {
+    case 0xcc: case 0xd0: *hdr = 2; break;
+    case 0xcd: case 0xd1: *hdr = 3; break;
+    case 0xca: case 0xce: case 0xd2: *hdr = 5; break;
+    case 0xcb: case 0xcf: case 0xd3: *hdr = 9; break;
+
+    // fixext: the type, then 1 to 16 bytes
+    case 0xd4: *hdr = 2; *body = 1; break;
+    case 0xd5: *hdr = 2; *body = 2; break;
+    case 0xd6: *hdr = 2; *body = 4; break;
+    case 0xd7: *hdr = 2; *body = 8; break;
+    case 0xd8: *hdr = 2; *body = 16; break;
+
+    case 0xc4: case 0xd9: case 0xc7:
+        *hdr = (b == 0xc7) ? 3 : 2;
+        if (avail < *hdr) {
+            return false;
+        }
+        *body = (unsigned char) p[1];
+        break;
+
+    case 0xc5: case 0xda: case 0xc8: case 0xdc: case 0xde:
+        *hdr = (b == 0xc8) ? 4 : 3;
+        if (avail < *hdr) {
+            return false;
+        }
+        if (b == 0xdc) {
+            *children = _msgpack_load16(uint16_t, (p + 1));
+        } else if (b == 0xde) {
+            *children = 2 * (uint64_t) _msgpack_load16(uint16_t, (p + 1));
+        } else {
+            *body = _msgpack_load16(uint16_t, (p + 1));
+        }
+        break;
+
+    case 0xc6: case 0xdb: case 0xc9: case 0xdd: case 0xdf:
+        *hdr = (b == 0xc9) ? 6 : 5;
+        if (avail < *hdr) {
+            return false;
+        }
+        if (b == 0xdd) {
+            *children = _msgpack_load32(uint32_t, (p + 1));
+        } else if (b == 0xdf) {
+            *children = 2 * (uint64_t) _msgpack_load32(uint32_t, (p + 1));
+        } else {
+            *body = _msgpack_load32(uint32_t, (p + 1));
+        }
+        break;
+
+    default:
+        return false;
+    }
+
+    return *hdr <= avail && *body <= avail - *hdr;
+}
+
+// The end of the object at `p', or NULL if it is malformed or cut short
+static const char *
+skip_object(const char *p, const char *end) {
+    uint64_t n = 1;
+
+    while (n > 0) {
+        size_t hdr, body;
+        uint64_t children;
+        if (!header_at(p, end, &hdr, &body, &children)) {
+            return NULL;
+        }
+
+        p += hdr + body;
+        n += children - 1;
+    }
+
+    return p;
+}
+
+// A lower bound on the length of the message starting at `begin' and cut
+// short at `end': the headers there, the bodies they announce and a byte
+// for each object not reached yet
+static size_t
+message_bound(const char *begin, const char *end) {
+    const char *p = begin;
+    uint64_t n = 1;
+
+    while (n > 0) {
+        if (p >= end) {
+            return (p - begin) + n;
+        }
+
+        size_t hdr, body;
+        uint64_t children;
+        if (!header_at(p, end, &hdr, &body, &children)) {
+            size_t bound = (p - begin) + hdr + body + (n - 1);
+            return (bound > (size_t) (end - begin)) ?
+                bound :
+                (end - begin) + 1;
+        }
+
+        p += hdr + body;
+        n += children - 1;
+    }
+
+    return p - begin;
+}
+
+// The encoded object at `path' in the message at `p', walking the bytes
+// like path_lookup() walks objects, or NULL
+static const char *
+path_find(const char *p, const char *end, Handle<Array> path,
+          msgpack_zone *mz) {
+    for (uint32_t i = 0, l = path->Length(); i < l; i++) {
+        Local<Value> k = path->Get(i);
+
+        size_t hdr, body;
+        uint64_t n;
+        if (!header_at(p, end, &hdr, &body, &n)) {
+            return NULL;
+        }
+
+        unsigned char b = *p;
+        bool array = (b & 0xf0) == 0x90 || b == 0xdc || b == 0xdd;
+        bool map = (b & 0xf0) == 0x80 || b == 0xde || b == 0xdf;
+
+        p += hdr;
+
+        if (array && k->IsUint32()) {
+            if (k->Uint32Value() >= n) {
+                return NULL;
+            }
+            for (uint32_t j = 0; j < k->Uint32Value() && p; j++) {
+                p = skip_object(p, end);
+            }
+            if (p == NULL) {
+                return NULL;
+            }
+            continue;
+        }
+
+        if (!map) {
+            return NULL;
+        }
+
+        msgpack_object key;
+        MsgpackCycle mc;
+        v8_to_msgpack(k, &key, mz, &mc, 0);
+
+        const char *found = NULL;
+        for (uint64_t j = 0; j < n / 2 && !found; j++) {
+            const char *kend = skip_object(p, end);
+            if (kend == NULL) {
+                return NULL;
+            }
+
+            msgpack_object ko;
+            size_t off = 0;
+            if (msgpack_unpack(p, kend - p, &off, mz, &ko) ==
+                    MSGPACK_UNPACK_SUCCESS &&
+                msgpack_object_equal(ko, key)) {
+                found = kend;
+            } else if ((p = skip_object(kend, end)) == NULL) {
+                return NULL;
+            }
+        }
+
+        if (found == NULL) {
+            return NULL;
+        }
+        p = found;
+    }
+
+    return p;
+}
+
+// Whether an integer fits [min, max]
+static inline bool
+int_fits(const msgpack_object *mo, int64_t min, uint64_t max) {
+    return (mo->type == MSGPACK_OBJECT_POSITIVE_INTEGER) ?
+        mo->via.u64 <= max :
+        mo->via.i64 >= min;
+}
+
+// Overwrite the scalar encoded at `p' with `mo' if it fits the same
+// encoding
+static bool
+patch_scalar(unsigned char *p, size_t hdr, size_t body, msgpack_object *mo) {
+    unsigned char b = p[0];
+    bool integer = mo->type == MSGPACK_OBJECT_POSITIVE_INTEGER ||
+                   mo->type == MSGPACK_OBJECT_NEGATIVE_INTEGER;
+    int64_t i = (mo->type == MSGPACK_OBJECT_POSITIVE_INTEGER) ?
+        (int64_t) mo->via.u64 :
+        mo->via.i64;
+
+    switch (mo->type) {
+    case MSGPACK_OBJECT_NIL:
+        return b == 0xc0;
+
+    case MSGPACK_OBJECT_BOOLEAN:
+        if (b != 0xc2 && b != 0xc3) {
+            return false;
+        }
+        p[0] = mo->via.boolean ? 0xc3 : 0xc2;
+        return true;
+
+    case MSGPACK_OBJECT_RAW:
+    case MSGPACK_OBJECT_BIN: {
+        bool str = (b & 0xe0) == 0xa0 || b == 0xd9 || b == 0xda || b == 0xdb;
+        bool bin = b == 0xc4 || b == 0xc5 || b == 0xc6;
+        if ((mo->type == MSGPACK_OBJECT_RAW) ? !str : !bin) {
+            return false;
+        }
+        const char *ptr = (mo->type == MSGPACK_OBJECT_RAW) ?
+            mo->via.raw.ptr :
+            mo->via.bin.ptr;
+        size_t size = (mo->type == MSGPACK_OBJECT_RAW) ?
+            mo->via.raw.size :
+            mo->via.bin.size;
+        if (size != body) {
+            return false;
+        }
+        memcpy(p + hdr, ptr, body);
+        return true;
+    }
+
+    default:
+        break;
+    }
+
+    if (b <= 0x7f || b >= 0xe0) {
+        if (!integer || !int_fits(mo, -32, 127)) {
+            return false;
+        }
+        p[0] = (unsigned char) (int8_t) i;
+        return true;
+    }
+
+    switch (b) {
+    case 0xcc:
+        if (!integer || !int_fits(mo, 0, 0xff)) {
+            return false;
+        }
+        p[1] = (unsigned char) i;
+        return true;
+
+    case 0xcd:
+        if (!integer || !int_fits(mo, 0, 0xffff)) {
+            return false;
+        }
+        _msgpack_store16(p + 1, (uint16_t) i);
+        return true;
+
+    case 0xce:
+        if (!integer || !int_fits(mo, 0, 0xffffffffULL)) {
+            return false;
+        }
+        _msgpack_store32(p + 1, (uint32_t) i);
+        return true;
+
+    case 0xcf:
+        if (!integer || !int_fits(mo, 0, 0xffffffffffffffffULL)) {
+            return false;
+        }
+        _msgpack_store64(p + 1, mo->via.u64);
+        return true;
+
+    case 0xd0:
+        if (!integer || !int_fits(mo, -128, 127)) {
+            return false;
+        }
+        p[1] = (unsigned char) (int8_t) i;
+        return true;
+
+    case 0xd1:
+        if (!integer || !int_fits(mo, -32768, 32767)) {
+            return false;
+        }
+        _msgpack_store16(p + 1, (uint16_t) (int16_t) i);
+        return true;
+
+    case 0xd2:
+        if (!integer || !int_fits(mo, -2147483648LL, 2147483647)) {
+            return false;
+        }
+        _msgpack_store32(p + 1, (uint32_t) (int32_t) i);
+        return true;
+
+    case 0xd3:
+        if (!integer ||
+            !int_fits(mo, -9223372036854775807LL - 1, 0x7fffffffffffffffULL)) {
+            return false;
+        }
+        _msgpack_store64(p + 1, (uint64_t) i);
+        return true;
+
+    case 0xca:
+    case 0xcb: {
+        double d;
+        if (mo->type == MSGPACK_OBJECT_DOUBLE) {
+            d = mo->via.dec;
+        } else if (integer && int_fits(mo, -(1LL << 53), 1ULL << 53)) {
+            d = (double) i;
+        } else {
+            return false;
+        }
+
+        if (b == 0xca) {
+            if (!float32_exact(d)) {
+                return false;
+            }
+            float f = (float) d;
+            uint32_t u;
+            memcpy(&u, &f, 4);
+            _msgpack_store32(p + 1, u);
+        } else {
+            uint64_t u;
+            memcpy(&u, &d, 8);
+            _msgpack_store64(p + 1, u);
+        }
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+// var patched = msgpack.patch(buf, path, value);
+//
+// Overwrite the scalar at `path' in the message at the start of `buf', as
+// for peek(), with `value' in place, if it fits the encoding already
+// there: integers the same width and range, floats the same precision,
+// strings and Buffers the same length, booleans and nil. Returns false,
+// leaving `buf' alone, if the message has to be packed again instead.
+// Numbers packed with the `pin' option of packWith() always fit.
+static Handle<Value>
+patch(const Arguments &args) {
+    HandleScope scope;
+
+    if (!Buffer::HasInstance(args[0])) {
+        return ThrowException(Exception::TypeError(
+            String::New("First argument must be a Buffer")));
+    }
+    if (!args[1]->IsArray()) {
+        return ThrowException(Exception::TypeError(
+            String::New("Second argument must be an Array")));
+    }
+
+    Handle<Object> buf = args[0]->ToObject();
+    const char *data = Buffer::Data(buf);
+    const char *end = data + Buffer::Length(buf);
+
+    MsgpackZone mz;
+    MsgpackCycle mc;
+    msgpack_object mo;
+
+    try {
+        const char *p = path_find(data, end, Handle<Array>::Cast(args[1]),
+                                  &mz._mz);
+
+        size_t hdr, body;
+        uint64_t children;
+        if (p == NULL || !header_at(p, end, &hdr, &body, &children)) {
+            return ThrowException(Exception::Error(
+                String::New("Nothing to patch at that path")));
+        }
+
+        v8_to_msgpack(args[2], &mo, &mz._mz, &mc, 0);
+
+        // Containers and timestamps are never patched
+        if (children > 0 || mo.type == MSGPACK_OBJECT_ARRAY ||
+            mo.type == MSGPACK_OBJECT_MAP || mo.type == MSGPACK_OBJECT_EXT) {
+            return scope.Close(False());
+        }
+
+        return scope.Close(Boolean::New(
+            patch_scalar((unsigned char*) p, hdr, body, &mo)));
+    } catch (MsgpackException e) {
+        return ThrowException(e.getThrownException());
+    }
+}
+
+// var crc = msgpack.crc32c(buf[, crc]);
+//
+// Compute the CRC32C of `buf', continuing from the `crc' of the bytes
+// before it if given, so that a message spread over several Buffers can
+// be checked piece by piece.
+static Handle<Value>
+crc32c(const Arguments &args) {
+    HandleScope scope;
+
+    if (!Buffer::HasInstance(args[0])) {
+        return ThrowException(Exception::TypeError(
+            String::New("First argument must be a Buffer")));
+    }
+
+    uint32_t crc = (args.Length() > 1) ? args[1]->Uint32Value() : 0;
+
+    Handle<Object> buf = args[0]->ToObject();
+    return scope.Close(Integer::NewFromUnsigned(
+        msgpack_crc32c(crc, Buffer::Data(buf), Buffer::Length(buf))));
+}
+
+// mpBindings.setInheritable(fd, inheritable);
+//
+// Clear or set the close-on-exec flag of `fd', so that lib/ipc.js can hand
+// one end of a socketpair down to a child process, and only that one.
+static Handle<Value>
+set_inheritable(const Arguments &args) {
+    HandleScope scope;
+
+    if (!args[0]->IsInt32()) {
+        return ThrowException(Exception::TypeError(
+            String::New("First argument must be a file descriptor")));
+    }
+
+    int fd = args[0]->Int32Value();
+    int flags = fcntl(fd, F_GETFD);
+    if (flags >= 0) {
+        flags = args[1]->BooleanValue() ?
+            (flags & ~FD_CLOEXEC) :
+            (flags | FD_CLOEXEC);
+        flags = fcntl(fd, F_SETFD, flags);
+    }
+    if (flags < 0) {
+        return ThrowException(ErrnoException(errno, "fcntl"));
+    }
+
+    return Undefined();
+}
+
 extern "C" void
 init(Handle<Object> target) {
     HandleScope scope;
 
     NODE_SET_METHOD(target, "pack", pack);
+    NODE_SET_METHOD(target, "packCompat", pack_compat);
+    NODE_SET_METHOD(target, "packWith", pack_with);
+    NODE_SET_METHOD(target, "unpackInto", unpack_into);
+    NODE_SET_METHOD(target, "clone", clone);
+    NODE_SET_METHOD(target, "peek", peek);
+    NODE_SET_METHOD(target, "patch", patch);
+    NODE_SET_METHOD(target, "crc32c", crc32c);
+    NODE_SET_METHOD(target, "setInheritable", set_inheritable);
+
+    Local<FunctionTemplate> encoder = FunctionTemplate::New(MsgpackEncoder::New);
+    encoder->SetClassName(String::NewSymbol("Encoder"));
+    encoder->InstanceTemplate()->SetInternalFieldCount(1);
+    NODE_SET_PROTOTYPE_METHOD(encoder, "arrayHeader",
+                              MsgpackEncoder::ArrayHeader);
+    NODE_SET_PROTOTYPE_METHOD(encoder, "mapHeader", MsgpackEncoder::MapHeader);
+    NODE_SET_PROTOTYPE_METHOD(encoder, "value", MsgpackEncoder::PackValue);
+    NODE_SET_PROTOTYPE_METHOD(encoder, "raw", MsgpackEncoder::Raw);
+    NODE_SET_PROTOTYPE_METHOD(encoder, "flush", MsgpackEncoder::Flush);
+    target->Set(String::NewSymbol("Encoder"), encoder->GetFunction());
+
+    Local<FunctionTemplate> rope_unpacker =
+        FunctionTemplate::New(MsgpackRopeUnpacker::New);
+    rope_unpacker->SetClassName(String::NewSymbol("RopeUnpacker"));
+    rope_unpacker->InstanceTemplate()->SetInternalFieldCount(1);
+    NODE_SET_PROTOTYPE_METHOD(rope_unpacker, "execute",
+                              MsgpackRopeUnpacker::Execute);
+    NODE_SET_PROTOTYPE_METHOD(rope_unpacker, "partial",
+                              MsgpackRopeUnpacker::Partial);
+    target->Set(String::NewSymbol("RopeUnpacker"),
+                rope_unpacker->GetFunction());
+
+    msgpack_bytes_remaining_symbol = NODE_PSYMBOL("bytes_remaining");
+    msgpack_bytes_needed_symbol = NODE_PSYMBOL("bytes_needed");
+    msgpack_slice_symbol = NODE_PSYMBOL("slice");
+    msgpack_hi_symbol = NODE_PSYMBOL("hi");
+    msgpack_lo_symbol = NODE_PSYMBOL("lo");
+    msgpack_length_symbol = NODE_PSYMBOL("length");
+    msgpack_value_symbol = NODE_PSYMBOL("value");
+
+    msgpack_cache_symbols[0] = NODE_PSYMBOL("msgpack::encoded");
+    msgpack_cache_symbols[PACK_COMPAT] =
+        NODE_PSYMBOL("msgpack::encoded:compat");
+    msgpack_cache_symbols[PACK_FLOAT32] =
+        NODE_PSYMBOL("msgpack::encoded:float32");
+    msgpack_cache_symbols[PACK_COMPAT | PACK_FLOAT32] =
+        NODE_PSYMBOL("msgpack::encoded:compat:float32");
+
+    msgpack_is_frozen = Persistent<Function>::New(Handle<Function>::Cast(
+        Context::GetCurrent()->Global()
+            ->Get(String::NewSymbol("Object"))->ToObject()
+            ->Get(String::NewSymbol("isFrozen"))
+    ));
+    msgpack_freeze = Persistent<Function>::New(Handle<Function>::Cast(
+        Context::GetCurrent()->Global()
+            ->Get(String::NewSymbol("Object"))->ToObject()
+            ->Get(String::NewSymbol("freeze"))
+    ));
+    msgpack_get_own_property_descriptor = Persistent<Function>::New(
+        Handle<Function>::Cast(
+            Context::GetCurrent()->Global()
+                ->Get(String::NewSymbol("Object"))->ToObject()
+                ->Get(String::NewSymbol("getOwnPropertyDescriptor"))
+    ));
+    msgpack_object_prototype = Persistent<Value>::New(
+        Context::GetCurrent()->Global()
+            ->Get(String::NewSymbol("Object"))->ToObject()
+            ->Get(String::NewSymbol("prototype")));
+    msgpack_array_prototype = Persistent<Value>::New(
+        Context::GetCurrent()->Global()
+            ->Get(String::NewSymbol("Array"))->ToObject()
+            ->Get(String::NewSymbol("prototype")));
+
+    msgpack_unpack_cache_template = Persistent<FunctionTemplate>::New(
+        FunctionTemplate::New(MsgpackUnpackCache::New)
+    );
+    msgpack_unpack_cache_template->SetClassName(
+        String::NewSymbol("UnpackCache"));
+    msgpack_unpack_cache_template->InstanceTemplate()->SetInternalFieldCount(1);
+    NODE_SET_PROTOTYPE_METHOD(msgpack_unpack_cache_template, "stats",
+                              MsgpackUnpackCache::Stats);
+    NODE_SET_PROTOTYPE_METHOD(msgpack_unpack_cache_template, "clear",
+                              MsgpackUnpackCache::Clear);
+    target->Set(
+        String::NewSymbol("UnpackCache"),
+        msgpack_unpack_cache_template->GetFunction()
+    );
+
+    msgpack_int64_template = Persistent<FunctionTemplate>::New(
+        FunctionTemplate::New(int64_new)
+    );
+    msgpack_int64_template->SetClassName(String::NewSymbol("Int64"));
+    NODE_SET_PROTOTYPE_METHOD(msgpack_int64_template, "toString", int64_to_string);
+    NODE_SET_PROTOTYPE_METHOD(msgpack_int64_template, "valueOf", int64_value_of);
+    target->Set(
+        String::NewSymbol("Int64"),
+        msgpack_int64_template->GetFunction()
+    );
 
     // Go through this mess rather than call NODE_SET_METHOD so that we can set
     // a field on the function for 'bytes_remaining'.
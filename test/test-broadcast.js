@@ -0,0 +1,81 @@
+// Verify that broadcast() packs a message once for all Streams, that
+// messages queued in the same tick are coalesced into one write, and that
+// a Stream keeps its messages in order whichever way they are sent.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+var net = require('net');
+var netBindings = process.binding('net');
+
+var MSGS = [
+    {'event' : 'a', 'id' : 1},
+    [1, 2, 3],
+    'sent',
+    'x'
+];
+
+// Sending ends of socketpairs, each counting the writes made to it, and
+// the messages received at the other end
+var N = 3;
+var streams = [];
+var received = [];
+var writes = [];
+var ends = [];
+
+for (var i = 0; i < N; i++) {
+    (function(i) {
+        var fds = netBindings.socketpair();
+
+        var is = new net.Stream(fds[0]);
+        var ims = new msgpack.Stream(is);
+        received[i] = [];
+        ims.addListener('msg', function(m) {
+            received[i].push(m);
+            if (received[i].length == MSGS.length) {
+                is.end();
+                os.end();
+            }
+        });
+        is.resume();
+
+        var os = new net.Stream(fds[1]);
+        var write = os.write;
+        writes[i] = 0;
+        os.write = function() {
+            writes[i]++;
+            return write.apply(os, arguments);
+        };
+        streams.push(new msgpack.Stream(os));
+    })(i);
+}
+
+var b1 = msgpack.broadcast(streams, MSGS[0]);
+msgpack.broadcast(streams, MSGS[1]);
+assert.deepEqual(msgpack.unpack(b1), MSGS[0]);
+
+// Nothing is written until the next tick...
+writes.forEach(function(w) {
+    assert.equal(w, 0);
+});
+
+process.nextTick(function() {
+    // ...and then all at once
+    writes.forEach(function(w) {
+        assert.equal(w, 1);
+    });
+
+    // A message broadcast and one sent right after it go out in that order
+    msgpack.broadcast(streams, MSGS[2]);
+    streams.forEach(function(s) {
+        s.send(MSGS[3]);
+    });
+    writes.forEach(function(w) {
+        assert.equal(w, 3);
+    });
+});
+
+process.addListener('exit', function() {
+    received.forEach(function(r) {
+        assert.deepEqual(r, MSGS);
+    });
+});
@@ -0,0 +1,41 @@
+// Verify that clone() gives the same result as a pack() / unpack() round
+// trip and shares nothing with the original.
+
+var assert = require('assert');
+var buffer = require('buffer');
+var msgpack = require('msgpack');
+
+var o = {
+    'a' : [1, -2, 3.5, 4294967296, -70000],
+    'b' : {'c' : 'str', 'd' : 'é中', 'e' : null, 'f' : true},
+    'g' : new buffer.Buffer([1, 2, 3]),
+    'h' : new Date(1234567890123),
+    'i' : undefined
+};
+
+var c = msgpack.clone(o);
+assert.deepEqual(c, msgpack.unpack(msgpack.pack(o)));
+assert.notStrictEqual(c.a, o.a);
+assert.notStrictEqual(c.b, o.b);
+assert.ok(c.h instanceof Date);
+assert.equal(c.h.getTime(), o.h.getTime());
+
+// Buffers are copied
+assert.ok(buffer.Buffer.isBuffer(c.g));
+c.g[0] = 42;
+assert.equal(o.g[0], 1);
+
+// Scalars
+assert.equal(msgpack.clone('abc'), 'abc');
+assert.equal(msgpack.clone(1.5), 1.5);
+assert.strictEqual(msgpack.clone(undefined), null);
+
+// Int64 values that a Number can't hold survive
+var i = msgpack.clone(new msgpack.Int64(0x7fffffff, 0xffffffff));
+assert.ok(i instanceof msgpack.Int64);
+assert.equal(i.toString(), '9223372036854775807');
+
+// Circular references throw
+var cyc = [1];
+cyc.push(cyc);
+assert.throws(function() { msgpack.clone(cyc); });
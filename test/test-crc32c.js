@@ -0,0 +1,164 @@
+// Verify crc32c() and Streams sending their messages in CRC32C frames.
+
+var assert = require('assert');
+var buffer = require('buffer');
+var msgpack = require('msgpack');
+var net = require('net');
+var netBindings = process.binding('net');
+
+// The check value of CRC32C, over "123456789"
+var check = new buffer.Buffer([0x31, 0x32, 0x33, 0x34, 0x35,
+                               0x36, 0x37, 0x38, 0x39]);
+assert.equal(msgpack.crc32c(check), 0xe3069283);
+assert.equal(msgpack.crc32c(new buffer.Buffer(0)), 0);
+
+// The same, piece by piece
+assert.equal(msgpack.crc32c(check.slice(4, 9),
+                            msgpack.crc32c(check.slice(0, 4))),
+             0xe3069283);
+
+// Both ends of a socketpair, recording the Buffers written to the second
+var pair = function() {
+    var fds = netBindings.socketpair();
+    var is = new net.Stream(fds[0]);
+    var os = new net.Stream(fds[1]);
+
+    var write = os.write;
+    os.writes = [];
+    os.write = function(buf) {
+        os.writes.push(buf);
+        return write.apply(os, arguments);
+    };
+
+    return [is, os];
+};
+
+var streams = [];
+var waiting = 6;
+var done = function() {
+    if (--waiting == 0) {
+        streams.forEach(function(s) {
+            s.destroy();
+        });
+    }
+};
+
+// The messages and errors of a Stream over `s', once it is resumed
+var receive = function(s, opts, n) {
+    var r = {'msgs' : [], 'errors' : []};
+    var ms = new msgpack.Stream(s, opts);
+    ms.addListener('msg', function(m) {
+        r.msgs.push(m);
+        if (r.msgs.length + r.errors.length == n) {
+            done();
+        }
+    });
+    ms.addListener('error', function(e) {
+        r.errors.push(e);
+        if (r.msgs.length + r.errors.length == n) {
+            done();
+        }
+    });
+    s.resume();
+    return r;
+};
+
+var msgs = [{'a' : [1, 2, 3]}, 'hello', 42];
+
+// Each frame is the message behind its length and CRC32C
+var p = pair();
+streams.push(p[0], p[1]);
+var sender = new msgpack.Stream(p[1], {crc32c : true});
+msgs.forEach(function(m) {
+    sender.send(m);
+});
+var framed = receive(p[0], {crc32c : true}, msgs.length);
+
+var body = msgpack.pack(msgs[0]);
+var f = p[1].writes[0];
+assert.equal(f.length, 8 + body.length);
+assert.equal((f[0] << 24) | (f[1] << 16) | (f[2] << 8) | f[3], body.length);
+assert.equal(((f[4] << 24) | (f[5] << 16) | (f[6] << 8) | f[7]) >>> 0,
+             msgpack.crc32c(body));
+
+// Frames are read back whatever the pieces they are written in, and a
+// corrupted one is an error and is skipped, the next one is read
+var raw = pair();
+streams.push(raw[0], raw[1]);
+var pieces = receive(raw[0], {crc32c : true}, msgs.length + 2);
+
+p[1].writes.forEach(function(w) {
+    for (var i = 0; i < w.length; i++) {
+        raw[1].write(w.slice(i, i + 1));
+    }
+});
+
+var bad = new buffer.Buffer(p[1].writes[1].length);
+p[1].writes[1].copy(bad, 0, 0, bad.length);
+bad[bad.length - 1] ^= 0x01;
+raw[1].write(bad);
+raw[1].write(p[1].writes[2]);
+
+// A frame longer than maxFrame is refused before its bytes arrive
+var small = pair();
+streams.push(small[0], small[1]);
+var limited = receive(small[0], {crc32c : true, maxFrame : 4}, 1);
+small[1].write(p[1].writes[0].slice(0, 8));
+
+// Frames passing their checksum but holding no message, a truncated one or
+// one exceeding the limits are errors and are skipped too
+var frameOf = function(body) {
+    var f = new buffer.Buffer(8 + body.length);
+    var put32 = function(off, v) {
+        f[off] = (v >>> 24) & 0xff;
+        f[off + 1] = (v >>> 16) & 0xff;
+        f[off + 2] = (v >>> 8) & 0xff;
+        f[off + 3] = v & 0xff;
+    };
+    put32(0, body.length);
+    put32(4, msgpack.crc32c(body));
+    body.copy(f, 8, 0, body.length);
+    return f;
+};
+
+var invalid = pair();
+streams.push(invalid[0], invalid[1]);
+var skipped = receive(invalid[0], {crc32c : true, maxArrayLength : 2}, 4);
+var long = msgpack.pack([1, 2, 3]);
+invalid[1].write(frameOf(new buffer.Buffer(0)));
+invalid[1].write(frameOf(long.slice(0, 2)));
+invalid[1].write(frameOf(long));
+invalid[1].write(frameOf(msgpack.pack([1, 2])));
+
+// broadcast() to Streams framing differently
+var checked = pair();
+var plain = pair();
+streams.push(checked[0], checked[1], plain[0], plain[1]);
+var both = [
+    new msgpack.Stream(checked[1], {crc32c : true}),
+    new msgpack.Stream(plain[1], {frames : true}),
+    new msgpack.Stream(checked[1], {crc32c : true})
+];
+msgs.forEach(function(m) {
+    msgpack.broadcast(both, m);
+});
+var gotChecked = receive(checked[0], {crc32c : true}, 2 * msgs.length);
+var gotPlain = receive(plain[0], {frames : true}, msgs.length);
+
+process.addListener('exit', function() {
+    assert.deepEqual(framed.msgs, msgs);
+    assert.equal(framed.errors.length, 0);
+
+    assert.deepEqual(pieces.msgs, msgs.concat([42]));
+    assert.equal(pieces.errors.length, 1);
+
+    assert.deepEqual(skipped.msgs, [[1, 2]]);
+    assert.equal(skipped.errors.length, 3);
+
+    assert.deepEqual(limited.msgs, []);
+    assert.equal(limited.errors.length, 1);
+
+    assert.deepEqual(gotChecked.msgs, msgs.concat(msgs));
+    assert.deepEqual(gotPlain.msgs, msgs);
+    assert.equal(gotChecked.errors.length + gotPlain.errors.length, 0);
+});
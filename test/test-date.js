@@ -0,0 +1,32 @@
+// Verify that Dates round-trip through the timestamp extension type in
+// each of its forms.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+
+var check = function(d, len) {
+    var b = msgpack.pack(d);
+    assert.equal(b.length, len);
+
+    var dd = msgpack.unpack(b);
+    assert.ok(dd instanceof Date);
+    assert.equal(dd.getTime(), d.getTime());
+};
+
+// Whole seconds fit the 4-byte form, in fixext 4
+check(new Date(Date.UTC(2010, 5, 1, 12, 30, 15)), 6);
+
+// Milliseconds need the 8-byte form, in fixext 8
+check(new Date(Date.UTC(2010, 5, 1, 12, 30, 15, 123)), 10);
+
+// Dates before 1970 or after 2514 need the 12-byte form, in ext 8
+check(new Date(Date.UTC(1969, 11, 31, 23, 59, 59, 999)), 15);
+check(new Date(Date.UTC(2600, 0, 1)), 15);
+
+// Nested in other objects
+var o = {'when' : new Date(1234567890123), 'list' : [new Date(0)]};
+assert.deepEqual(msgpack.unpack(msgpack.pack(o)), o);
+
+// Old-spec peers get milliseconds
+assert.equal(msgpack.unpack(msgpack.packCompat(new Date(1234567890123))),
+             1234567890123);
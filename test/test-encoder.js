@@ -0,0 +1,83 @@
+// Verify that Encoder packs incrementally into fixed-size chunks and passes
+// on the backpressure of its stream.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+var net = require('net');
+var netBindings = process.binding('net');
+
+// Both ends of a socketpair, recording the Buffers written to the second
+var pair = function() {
+    var fds = netBindings.socketpair();
+    var is = new net.Stream(fds[0]);
+    var os = new net.Stream(fds[1]);
+
+    var write = os.write;
+    os.writes = [];
+    os.write = function(buf) {
+        os.writes.push(buf);
+        return write.apply(os, arguments);
+    };
+
+    return [is, os];
+};
+
+var fds = pair();
+var is = fds[0];
+var os = fds[1];
+
+var enc = new msgpack.Encoder(os, {chunkSize : 16});
+
+var expect = [];
+enc.arrayHeader(1001);
+for (var i = 0; i < 1000; i++) {
+    var v = {'i' : i, 's' : 'x' + i};
+    enc.value(v);
+    expect.push(v);
+}
+enc.mapHeader(1);
+enc.value('raw');
+enc.raw(msgpack.pack([1, 2, 3]));
+expect.push({'raw' : [1, 2, 3]});
+enc.flush();
+
+// Full chunks, except for the last one
+for (var i = 0; i < os.writes.length - 1; i++) {
+    assert.equal(os.writes[i].length, 16);
+}
+assert.ok(os.writes[os.writes.length - 1].length <= 16);
+
+// Large raw Buffers are written as they are
+var n = os.writes.length;
+var big = msgpack.pack(new Array(100).join('y'));
+enc.value(1);
+enc.raw(big);
+enc.flush();
+assert.equal(os.writes.length, n + 2);
+assert.strictEqual(os.writes[n + 1], big);
+
+var received = [];
+new msgpack.Stream(is).addListener('msg', function(m) {
+    received.push(m);
+    if (received.length == 3) {
+        is.end();
+        os.end();
+    }
+});
+is.resume();
+
+// Backpressure is reported by the call that filled a chunk. Nobody reads
+// `full', so the megabyte written first leaves its stream pushing back.
+var full = pair();
+var enc2 = new msgpack.Encoder(full[1], {chunkSize : 16});
+assert.ok(!enc2.raw(msgpack.pack(new Array(1048577).join('w'))));
+assert.ok(enc2.value(1));
+assert.ok(!enc2.value(new Array(20).join('z')));
+assert.ok(!enc2.flush());
+assert.ok(enc2.flush());
+full[0].destroy();
+full[1].destroy();
+
+process.addListener('exit', function() {
+    assert.deepEqual(received, [expect, 1, new Array(100).join('y')]);
+});
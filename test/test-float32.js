@@ -0,0 +1,38 @@
+// Verify that packWith({float32: true}) packs doubles that a float holds
+// exactly in 5 bytes, and everything else as before.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+
+var opts = {float32 : true};
+
+[0.5, -1.25, 3.140625, Infinity, -Infinity].forEach(function(n) {
+    var b = msgpack.packWith(opts, n);
+    assert.equal(b.length, 5);
+    assert.equal(b[0], 0xca);
+    assert.strictEqual(msgpack.unpack(b), n);
+});
+
+var nan = msgpack.packWith(opts, NaN);
+assert.equal(nan.length, 5);
+assert.ok(isNaN(msgpack.unpack(nan)));
+
+// Not exact as a float; still 9 bytes
+[0.1, 1 / 3, 1e300, 1.0000001].forEach(function(n) {
+    var b = msgpack.packWith(opts, n);
+    assert.equal(b.length, 9);
+    assert.strictEqual(msgpack.unpack(b), n);
+});
+
+// Integers keep their smallest forms
+assert.equal(msgpack.packWith(opts, 7).length, 1);
+assert.equal(msgpack.packWith(opts, 70000).length, 5);
+
+// Without the option nothing changes
+assert.equal(msgpack.pack(0.5).length, 9);
+
+// Several objects, in arrays and maps
+var o = {'xs' : [0.5, 0.25, 0.1, 2], 'y' : -0.75};
+var b = msgpack.packWith(opts, o, o);
+assert.equal(b.length, msgpack.pack(o).length * 2 - 2 * 3 * 4);
+assert.deepEqual(msgpack.unpack(b), o);
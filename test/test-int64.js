@@ -0,0 +1,55 @@
+// Verify that integers of up to 64 bits unpack exactly: as Numbers while
+// they are safe, and as Int64 objects in int64 mode beyond that.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+
+// 32-bit and 53-bit integers used to be truncated to 32 bits
+[0, 1, -1, 4294967295, 4294967296, -2147483649, 9007199254740992,
+ -9007199254740992, 1234567890123].forEach(function(n) {
+    assert.strictEqual(msgpack.unpack(msgpack.pack(n)), n);
+    assert.strictEqual(msgpack.unpack(msgpack.pack(n), {int64 : true}), n);
+});
+
+// 2^63 + 1 as a uint 64
+var b = msgpack.pack(new msgpack.Int64(0x80000000, 1));
+assert.equal(b.length, 9);
+assert.equal(b[0], 0xcf);
+
+// Without int64 mode it is the nearest Number
+assert.equal(msgpack.unpack(b), 9223372036854775808);
+
+var i = msgpack.unpack(b, {int64 : true});
+assert.ok(i instanceof msgpack.Int64);
+assert.equal(i.hi, 0x80000000);
+assert.equal(i.lo, 1);
+assert.equal(i.toString(), '9223372036854775809');
+assert.deepEqual(msgpack.pack(i), b);
+
+// -2^63 as an int 64
+b = msgpack.pack(new msgpack.Int64(-0x80000000, 0));
+assert.equal(b[0], 0xd3);
+i = msgpack.unpack(b, {int64 : true});
+assert.equal(i.toString(), '-9223372036854775808');
+assert.equal(i.hi, -0x80000000);
+assert.equal(+i, -9223372036854775808);
+
+// Nested, and through a Stream-style rope
+var o = {'id' : new msgpack.Int64(0x12345678, 0x9abcdef0), 'n' : 5};
+b = msgpack.pack(o);
+var oo = msgpack.unpack([b.slice(0, 4), b.slice(4)], {int64 : true});
+assert.equal(oo.id.toString(), '1311768467463790320');
+assert.equal(oo.n, 5);
+
+// `hi' must fit the high word of an int64 or uint64
+[undefined, NaN, 0.5, -0x80000001, 0x100000000, Infinity].forEach(function(hi) {
+    assert.throws(function() { new msgpack.Int64(hi, 0); }, RangeError);
+});
+assert.equal(new msgpack.Int64(0xffffffff, 0xffffffff).toString(),
+             '18446744073709551615');
+
+// Nor is one changed afterwards packed
+i = new msgpack.Int64(1, 0);
+i.hi = 0.5;
+assert.throws(function() { msgpack.pack(i); });
+assert.throws(function() { i.toString(); });
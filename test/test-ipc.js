@@ -0,0 +1,60 @@
+// Verify that msgpack.ipc channels pass messages between a process and a
+// child it spawns. This same script is the child, which echoes every
+// message back.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+
+var channel = msgpack.ipc.channel();
+if (channel) {
+    channel.addListener('msg', function(m) {
+        channel.send(m);
+    });
+    channel.stream.addListener('end', function() {
+        channel.stream.end();
+    });
+    return;
+}
+
+// A message larger than a single read, to arrive in many pieces
+var big = [];
+for (var i = 0; i < 20000; i++) {
+    big.push({'i' : i, 's' : 'abcdefghijklmnopqrstuvwxyz'});
+}
+
+var MSGS = [
+    [1, 2, 3],
+    {'a' : 1, 'b' : 2},
+    big,
+    'last'
+];
+
+var child = msgpack.ipc.spawn(process.execPath, [__filename]);
+child.stderr.addListener('data', function(d) {
+    process.stdout.write(d);
+});
+
+var msgsReceived = 0;
+child.channel.addListener('msg', function(m) {
+    assert.deepEqual(m, MSGS[msgsReceived]);
+
+    if (++msgsReceived == MSGS.length) {
+        child.channel.stream.end();
+    }
+});
+
+var exited = false;
+child.addListener('exit', function(code) {
+    assert.equal(code, 0);
+    exited = true;
+});
+
+// Messages sent in the same tick are written at once
+MSGS.forEach(function(m) {
+    child.channel.send(m);
+});
+
+process.addListener('exit', function() {
+    assert.equal(msgsReceived, MSGS.length);
+    assert.ok(exited);
+});
@@ -0,0 +1,67 @@
+// Verify that packing with {cache : true} gives the same bytes as without,
+// and only reuses them for objects that can't change.
+
+var assert = require('assert');
+var buffer = require('buffer');
+var msgpack = require('msgpack');
+
+var inner = Object.freeze([1, 'two', 3.5, null]);
+var config = Object.freeze({'a' : inner, 'b' : 'str', 'c' : -70000});
+var opts = {cache : true};
+
+var expect = msgpack.pack(config);
+for (var i = 0; i < 3; i++) {
+    assert.deepEqual(msgpack.packWith(opts, config), expect);
+}
+
+// Cached objects nested in others
+var msg = {'type' : 'config', 'data' : config, 'list' : [inner, inner]};
+assert.deepEqual(msgpack.packWith(opts, msg), msgpack.pack(msg));
+assert.deepEqual(msgpack.unpack(msgpack.packWith(opts, msg)), msg);
+
+// Each set of options has its own encoding
+assert.deepEqual(
+    msgpack.packWith({cache : true, float32 : true}, config),
+    msgpack.packWith({float32 : true}, config)
+);
+assert.deepEqual(
+    msgpack.packWith({cache : true, compat : true}, config),
+    msgpack.packCompat(config)
+);
+
+// Objects that aren't frozen all the way down are packed afresh
+var mutable = {'x' : 1};
+var shallow = Object.freeze({'m' : mutable});
+msgpack.packWith(opts, shallow);
+mutable.x = 2;
+assert.deepEqual(msgpack.unpack(msgpack.packWith(opts, shallow)), {'m' : {'x' : 2}});
+
+var buf = new buffer.Buffer([1, 2]);
+var withBuf = Object.freeze({'b' : buf});
+msgpack.packWith(opts, withBuf);
+buf[0] = 9;
+assert.equal(msgpack.unpack(msgpack.packWith(opts, withBuf)).b[0], 9);
+
+var d = new Date(1000);
+var withDate = Object.freeze([d]);
+msgpack.packWith(opts, withDate);
+d.setTime(2000);
+assert.equal(msgpack.unpack(msgpack.packWith(opts, withDate))[0].getTime(), 2000);
+
+// Getters and properties inherited from a prototype can change too
+var n = 1;
+var withGetter = {};
+Object.defineProperty(withGetter, 'g', {
+    get : function() { return n; },
+    enumerable : true
+});
+Object.freeze(withGetter);
+msgpack.packWith(opts, withGetter);
+n = 2;
+assert.deepEqual(msgpack.unpack(msgpack.packWith(opts, withGetter)), {'g' : 2});
+
+var proto = {'p' : 1};
+var inherits = Object.freeze(Object.create(proto));
+msgpack.packWith(opts, inherits);
+proto.p = 2;
+assert.deepEqual(msgpack.unpack(msgpack.packWith(opts, inherits)), {'p' : 2});
@@ -0,0 +1,67 @@
+// Verify that patch() overwrites scalars in place when they fit, and that
+// pinned numbers always do.
+
+var assert = require('assert');
+var buffer = require('buffer');
+var msgpack = require('msgpack');
+
+var o = {
+    'n' : 300,
+    'neg' : -5,
+    'f' : 1.5,
+    'ok' : true,
+    's' : 'abc',
+    'b' : new buffer.Buffer([1, 2]),
+    'list' : [1, {'deep' : 7}]
+};
+var b = msgpack.pack(o);
+
+var check = function(path, value, expect) {
+    assert.equal(msgpack.patch(b, path, value), expect);
+};
+
+check(['n'], 65535, true);
+check(['n'], 65536, false);
+check(['n'], -1, false);
+check(['neg'], -32, true);
+check(['neg'], -33, false);
+check(['f'], 2.25, true);
+check(['f'], 7, true);
+check(['ok'], false, true);
+check(['ok'], 1, false);
+check(['s'], 'xyz', true);
+check(['s'], 'xy', false);
+check(['b'], new buffer.Buffer([3, 4]), true);
+check(['b'], 'ab', false);
+check(['list', 1, 'deep'], 100, true);
+check(['list'], 5, false);
+
+var u = msgpack.unpack(b);
+assert.equal(u.n, 65535);
+assert.equal(u.neg, -32);
+assert.equal(u.f, 7);
+assert.equal(u.ok, false);
+assert.equal(u.s, 'xyz');
+assert.deepEqual(u.b, new buffer.Buffer([3, 4]));
+assert.deepEqual(u.list, [1, {'deep' : 100}]);
+
+assert.throws(function() { msgpack.patch(b, ['nothing'], 1); });
+assert.throws(function() { msgpack.patch(b, ['list', 2], 1); });
+
+// Pinned numbers take 9 bytes and fit anything
+var pb = msgpack.packWith({pin : ['hits', 'ts']}, {'hits' : 0, 'ts' : 1.5, 'x' : 0});
+assert.equal(pb.length, msgpack.pack({'hits' : 0, 'ts' : 1.5, 'x' : 0}).length + 8);
+assert.ok(msgpack.patch(pb, ['hits'], 4294967296 * 1000));
+assert.ok(msgpack.patch(pb, ['ts'], 1e300));
+assert.ok(!msgpack.patch(pb, ['x'], 1000));
+assert.deepEqual(msgpack.unpack(pb),
+                 {'hits' : 4294967296 * 1000, 'ts' : 1e300, 'x' : 0});
+
+// Headers with 16 and 32-bit lengths are walked too
+var long = [];
+for (var i = 0; i < 20; i++) {
+    long.push(i);
+}
+var lb = msgpack.pack({'pad' : new Array(301).join('p'), 'long' : long});
+assert.ok(msgpack.patch(lb, ['long', 18], 99));
+assert.equal(msgpack.unpack(lb).long[18], 99);
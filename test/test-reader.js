@@ -0,0 +1,86 @@
+// Verify that Reader yields the tokens and values of a message pushed in
+// pieces of any size.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+
+var rows = [];
+for (var i = 0; i < 300; i++) {
+    rows.push({'id' : i, 'name' : 'row' + i, 'tags' : [i, -i]});
+}
+var b = msgpack.pack(rows, {'a' : [1, 2]}, 'end');
+
+[1, 2, 7, 100, b.length].forEach(function(step) {
+    var r = new msgpack.Reader();
+    var tokens = [];
+    var got = [];
+    var header = null;
+
+    for (var off = 0; off < b.length; off += step) {
+        r.push(b.slice(off, Math.min(off + step, b.length)));
+
+        if (!header && !(header = r.next())) {
+            continue;
+        }
+
+        // The rows, one at a time
+        while (got.length < header.length) {
+            var row = r.readValue();
+            if (row === undefined) {
+                break;
+            }
+            got.push(row);
+        }
+
+        // Then the rest token by token
+        if (got.length == header.length) {
+            var t;
+            while ((t = r.next()) !== undefined) {
+                tokens.push(t);
+            }
+        }
+    }
+
+    assert.deepEqual(header, {'type' : 'array', 'length' : 300});
+    assert.deepEqual(got, rows);
+    assert.deepEqual(tokens, [
+        {'type' : 'map', 'length' : 1},
+        {'type' : 'value', 'value' : 'a'},
+        {'type' : 'array', 'length' : 2},
+        {'type' : 'value', 'value' : 1},
+        {'type' : 'value', 'value' : 2},
+        {'type' : 'value', 'value' : 'end'}
+    ]);
+    assert.equal(r.length, 0);
+});
+
+// 16 and 32-bit headers
+var r = new msgpack.Reader();
+var big = [];
+for (var i = 0; i < 70000; i++) {
+    big.push(0);
+}
+r.push(msgpack.pack(big).slice(0, 4));
+assert.equal(r.next(), undefined);
+r.push(msgpack.pack(big).slice(4, 5));
+assert.deepEqual(r.next(), {'type' : 'array', 'length' : 70000});
+
+r = new msgpack.Reader();
+r.push(msgpack.pack(big.slice(0, 20)).slice(0, 2));
+assert.equal(r.next(), undefined);
+r.push(msgpack.pack(big.slice(0, 20)).slice(2, 3));
+assert.deepEqual(r.next(), {'type' : 'array', 'length' : 20});
+
+// A value pushed a byte at a time is parsed as it arrives, and next() goes
+// on with it once started
+var s = new Array(5001).join('s');
+var sb = msgpack.pack(s, 7);
+r = new msgpack.Reader();
+for (var i = 0; i < sb.length - 2; i++) {
+    r.push(sb.slice(i, i + 1));
+    assert.strictEqual((i % 2) ? r.readValue() : r.next(), undefined);
+    assert.equal(r.length, 0);
+}
+r.push(sb.slice(sb.length - 2));
+assert.deepEqual(r.next(), {'type' : 'value', 'value' : s});
+assert.equal(r.readValue(), 7);
@@ -0,0 +1,142 @@
+// Verify that peek() finds frames and fields, and that Router forwards the
+// original bytes by field with backpressure.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+var net = require('net');
+var netBindings = process.binding('net');
+
+// peek()
+var m = {'header' : {'service' : 'a', 'id' : 7}, 'body' : [1, 2, 3]};
+var b = msgpack.pack(m, 'next');
+var r = msgpack.peek(b, ['header', 'service']);
+assert.equal(r[0], msgpack.pack(m).length);
+assert.equal(r[1], 'a');
+assert.equal(msgpack.peek(b, ['body', 2])[1], 3);
+assert.deepEqual(msgpack.peek(b, [])[1], m);
+assert.strictEqual(msgpack.peek(b, ['nothing'])[1], undefined);
+assert.strictEqual(msgpack.peek(b, ['body', 3])[1], undefined);
+assert.strictEqual(msgpack.peek(b.slice(0, 5), ['header']), undefined);
+assert.ok(msgpack.peek.bytes_needed > 5);
+assert.ok(msgpack.peek.bytes_needed <= msgpack.pack(m).length);
+
+// The headers of a large string tell its whole length
+var big = msgpack.pack({'to' : 'a', 'data' : new Array(100001).join('x')});
+assert.strictEqual(msgpack.peek(big.slice(0, 20), ['to']), undefined);
+assert.equal(msgpack.peek.bytes_needed, big.length);
+
+// Both ends of a socketpair
+var pair = function() {
+    var fds = netBindings.socketpair();
+    return [new net.Stream(fds[0]), new net.Stream(fds[1])];
+};
+
+// The messages received on `s', once it is resumed
+var received = function(s) {
+    var got = [];
+    new msgpack.Stream(s).addListener('msg', function(m) {
+        got.push(m);
+    });
+    return got;
+};
+
+var streams = [];
+var waiting = 2;
+var done = function() {
+    if (--waiting == 0) {
+        streams.forEach(function(s) {
+            s.destroy();
+        });
+    }
+};
+
+// Frames come out whole and untouched, whatever reads they arrive in
+var src = pair();
+var a = pair();
+var bb = pair();
+streams.push(src[0], src[1], a[0], a[1], bb[0], bb[1]);
+
+var router = new msgpack.Router(['to']);
+router.addRoute('a', a[1]);
+router.addRoute('b', bb[1]);
+
+var unroutable = [];
+router.addListener('unroutable', function(frame, key) {
+    unroutable.push(key);
+});
+router.attach(src[0]);
+src[0].resume();
+
+var gotA = received(a[0]);
+var gotB = received(bb[0]);
+a[0].resume();
+bb[0].resume();
+
+var MSGS = [
+    {'to' : 'a', 'n' : 1},
+    {'to' : 'b', 'n' : 2},
+    {'to' : 'c', 'n' : 3},
+    {'to' : 'a', 'n' : 4, 'data' : new Array(300001).join('y')}
+];
+MSGS.forEach(function(m) {
+    src[1].write(msgpack.pack(m));
+});
+
+bb[0].addListener('data', function() {
+    if (gotA.length == 2 && gotB.length == 1) {
+        done();
+    }
+});
+a[0].addListener('data', function() {
+    if (gotA.length == 2 && gotB.length == 1) {
+        done();
+    }
+});
+
+// Backpressure: the source is paused while a route's stream is full. A
+// route removed meanwhile gives its queued frames back as 'unroutable',
+// resumes the source and leaves its stream alone.
+var src2 = pair();
+var full = pair();
+streams.push(src2[0], src2[1], full[0], full[1]);
+
+var router2 = new msgpack.Router(['to']);
+router2.addRoute('full', full[1]);
+
+var unroutable2 = [];
+router2.addListener('unroutable', function(frame, key) {
+    unroutable2.push(msgpack.unpack(frame).n);
+    if (unroutable2.length == 2) {
+        done();
+    }
+});
+
+var pauses = 0;
+var pause = src2[0].pause;
+src2[0].pause = function() {
+    pauses++;
+    pause.apply(src2[0], arguments);
+
+    process.nextTick(function() {
+        router2.removeRoute('full');
+        assert.equal(full[1].listeners('drain').length, 0);
+    });
+};
+
+router2.attach(src2[0]);
+src2[0].resume();
+
+// Nobody reads `full', so a megabyte can't all be written at once
+src2[1].write(msgpack.pack({'to' : 'full', 'n' : 1,
+                            'data' : new Array(1048577).join('z')}));
+src2[1].write(msgpack.pack({'to' : 'full', 'n' : 2}));
+src2[1].write(msgpack.pack({'to' : 'full', 'n' : 3}));
+
+process.addListener('exit', function() {
+    assert.deepEqual(gotA, [MSGS[0], MSGS[3]]);
+    assert.deepEqual(gotB, [MSGS[1]]);
+    assert.deepEqual(unroutable, ['c']);
+
+    assert.equal(pauses, 1);
+    assert.deepEqual(unroutable2, [2, 3]);
+});
@@ -0,0 +1,132 @@
+// Verify MessagePack-RPC calls between two Sessions: many in flight at once,
+// errors, notifications, timeouts, calls failed when the connection closes,
+// and the echo server.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+var net = require('net');
+var netBindings = process.binding('net');
+
+var fds = netBindings.socketpair();
+var ss = new net.Stream(fds[0]);
+var cs = new net.Stream(fds[1]);
+
+var notified = [];
+var server = new msgpack.rpc.Session(ss, {
+    echo : function(params, reply) {
+        reply(null, params);
+    },
+    add : function(params, reply) {
+        // Answer out of order
+        setTimeout(function() {
+            reply(null, params[0] + params[1]);
+        }, 10 - params[0]);
+    },
+    fail : function(params, reply) {
+        reply('failed: ' + params[0]);
+    },
+    failError : function(params, reply) {
+        reply(new Error('failed with an Error'));
+    },
+    throws : function(params, reply) {
+        throw new Error('oops');
+    },
+    slow : function(params, reply) {
+    },
+    log : function(params, reply) {
+        notified.push(params);
+    }
+});
+var client = new msgpack.rpc.Session(cs, {}, {timeout : 1000});
+ss.resume();
+cs.resume();
+
+var CALLS = 200;
+var outstanding = CALLS + 11;
+var done = function() {
+    if (--outstanding == 0) {
+        assert.deepEqual(notified, [['a'], ['b']]);
+        ss.end();
+        cs.end();
+    }
+};
+
+for (var i = 0; i < CALLS; i++) {
+    (function(i) {
+        client.call('echo', [i, 'x' + i], function(err, result) {
+            assert.equal(err, null);
+            assert.deepEqual(result, [i, 'x' + i]);
+            done();
+        });
+    })(i);
+}
+
+for (var i = 0; i < 4; i++) {
+    (function(i) {
+        client.call('add', [i, 100], function(err, result) {
+            assert.equal(err, null);
+            assert.equal(result, i + 100);
+            done();
+        });
+    })(i);
+}
+
+client.notify('log', ['a']);
+client.notify('log', ['b']);
+
+client.call('fail', ['x'], function(err, result) {
+    assert.equal(err, 'failed: x');
+    done();
+});
+client.call('failError', [], function(err, result) {
+    assert.equal(err, 'failed with an Error');
+    done();
+});
+client.call('throws', [], function(err, result) {
+    assert.equal(err, 'oops');
+    done();
+});
+client.call('nosuch', [], function(err, result) {
+    assert.equal(err, 'No such method: nosuch');
+    done();
+});
+client.call('slow', [], {timeout : 20}, function(err, result) {
+    assert.ok(err instanceof Error);
+    done();
+});
+
+// Calls in flight fail when the connection closes
+var fds2 = netBindings.socketpair();
+var ss2 = new net.Stream(fds2[0]);
+var cs2 = new net.Stream(fds2[1]);
+new msgpack.rpc.Session(ss2, {
+    slow : function(params, reply) {
+        cs2.destroy();
+    }
+});
+var client2 = new msgpack.rpc.Session(cs2);
+ss2.resume();
+cs2.resume();
+client2.call('slow', [], function(err, result) {
+    assert.ok(err instanceof Error);
+    ss2.destroy();
+    done();
+});
+
+// createEchoServer() answers echo on every connection
+var PORT = 17381;
+var echo = msgpack.rpc.createEchoServer();
+var echoConn = null;
+echo.addListener('connection', function(s) {
+    echoConn = s;
+});
+echo.listen(PORT, 'localhost', function() {
+    var c = msgpack.rpc.connect(PORT, 'localhost');
+    c.call('echo', [1, 'a', {'b' : [2]}], function(err, result) {
+        assert.equal(err, null);
+        assert.deepEqual(result, [1, 'a', {'b' : [2]}]);
+        echoConn.end();
+        echo.close();
+        done();
+    });
+});
@@ -0,0 +1,37 @@
+// Verify that strings and Buffers are packed as str and bin, that bin
+// unpacks to a Buffer sharing memory with the input, and that
+// packCompat() sticks to the old spec.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+var buffer = require('buffer');
+
+// 32 to 255 bytes get the 2-byte str 8 header
+var s = new Array(101).join('s');
+var b = msgpack.pack(s);
+assert.equal(b.length, 2 + 100);
+assert.equal(b[0], 0xd9);
+assert.equal(msgpack.unpack(b), s);
+
+var bin = new buffer.Buffer([0, 1, 2, 0xff]);
+b = msgpack.pack({'s' : 'abc', 'b' : bin});
+var o = msgpack.unpack(b);
+assert.equal(o.s, 'abc');
+assert.ok(buffer.Buffer.isBuffer(o.b));
+assert.deepEqual(Array.prototype.slice.call(o.b), [0, 1, 2, 0xff]);
+
+// The unpacked Buffer is a slice of the input, not a copy
+b[b.length - 1] = 0x7f;
+assert.equal(o.b[3], 0x7f);
+
+// Also across the Buffers of a rope
+o = msgpack.unpack([b.slice(0, 5), b.slice(5)]);
+assert.deepEqual(Array.prototype.slice.call(o.b), [0, 1, 2, 0x7f]);
+
+// The old spec has raw 16 instead of str 8 and no bin
+b = msgpack.packCompat(s);
+assert.equal(b.length, 3 + 100);
+assert.equal(b[0], 0xda);
+assert.equal(msgpack.unpack(b), s);
+assert.equal(msgpack.unpack(msgpack.packCompat(bin)).length, 4);
+assert.ok(!buffer.Buffer.isBuffer(msgpack.unpack(msgpack.packCompat(bin))));
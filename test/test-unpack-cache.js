@@ -0,0 +1,47 @@
+// Verify that an UnpackCache returns the same frozen value for the same
+// bytes and keeps to its size.
+
+var assert = require('assert');
+var buffer = require('buffer');
+var msgpack = require('msgpack');
+
+var cache = new msgpack.UnpackCache(2);
+var opts = {cache : cache};
+
+var o = {'a' : [1, 2, {'b' : 'str'}], 'c' : 1.5};
+var b = msgpack.pack(o);
+
+var v1 = msgpack.unpack(b, opts);
+assert.deepEqual(v1, o);
+assert.ok(Object.isFrozen(v1));
+assert.ok(Object.isFrozen(v1.a));
+assert.ok(Object.isFrozen(v1.a[2]));
+
+// The same bytes in another Buffer, with a trailing message
+var bb = msgpack.pack(o, 7);
+assert.strictEqual(msgpack.unpack(bb, opts), v1);
+assert.equal(msgpack.unpack.bytes_remaining, 1);
+assert.deepEqual(cache.stats(),
+                 {'hits' : 1, 'misses' : 1, 'evictions' : 0, 'entries' : 1});
+
+// Different bytes and different flags miss
+var o2 = {'a' : [1, 2, {'b' : 'other'}], 'c' : 1.5};
+assert.deepEqual(msgpack.unpack(msgpack.pack(o2), opts), o2);
+assert.notStrictEqual(msgpack.unpack(b, {cache : cache, int64 : true}), v1);
+assert.deepEqual(cache.stats(),
+                 {'hits' : 1, 'misses' : 3, 'evictions' : 1, 'entries' : 2});
+
+// o was the least recently used entry, and is gone
+assert.notStrictEqual(msgpack.unpack(b, opts), v1);
+
+// Messages with Buffers and Dates aren't cached
+var withBuf = msgpack.pack({'b' : new buffer.Buffer([1, 2])});
+assert.ok(!Object.isFrozen(msgpack.unpack(withBuf, opts)));
+assert.notStrictEqual(msgpack.unpack(withBuf, opts),
+                      msgpack.unpack(withBuf, opts));
+var withDate = msgpack.pack([new Date(1000)]);
+assert.equal(msgpack.unpack(withDate, opts)[0].getTime(), 1000);
+assert.equal(cache.stats().misses, 4);
+
+cache.clear();
+assert.equal(cache.stats().entries, 0);
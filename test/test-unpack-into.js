@@ -0,0 +1,61 @@
+// Verify that unpackInto() gives the same result as unpack() and reuses the
+// objects and arrays of its target.
+
+var assert = require('assert');
+var buffer = require('buffer');
+var msgpack = require('msgpack');
+
+var o = {'a' : [1, 2, 3], 'b' : {'c' : 'str', 'd' : 1.5}, 'e' : null};
+var t = msgpack.unpack(msgpack.pack(o));
+var a = t.a;
+var b = t.b;
+
+// Same shape, different values
+var o2 = {'a' : [4, 5, 6], 'b' : {'c' : 'other', 'd' : 2.5}, 'e' : true};
+assert.strictEqual(msgpack.unpackInto(msgpack.pack(o2), t), t);
+assert.deepEqual(t, o2);
+assert.strictEqual(t.a, a);
+assert.strictEqual(t.b, b);
+
+// Arrays shrink and grow, keys are added and removed
+var o3 = {'a' : [7], 'b' : {'d' : 3, 'f' : [1, 2]}, 'g' : 'new'};
+assert.strictEqual(msgpack.unpackInto(msgpack.pack(o3), t), t);
+assert.deepEqual(t, o3);
+assert.strictEqual(t.a, a);
+assert.strictEqual(t.b, b);
+assert.ok(!('e' in t));
+assert.ok(!('c' in t.b));
+
+var o4 = {'a' : [7, 8, 9, 10], 'b' : {'d' : 3, 'f' : [1, 2]}, 'g' : 'new'};
+assert.strictEqual(msgpack.unpackInto(msgpack.pack(o4), t), t);
+assert.deepEqual(t, o4);
+
+// Values of another type are replaced
+var o5 = {'a' : {'x' : 1}, 'b' : [1], 'g' : 'new'};
+assert.strictEqual(msgpack.unpackInto(msgpack.pack(o5), t), t);
+assert.deepEqual(t, o5);
+
+// Keys inherited from Object.prototype are not those of the target
+var t2 = {'x' : 1};
+assert.strictEqual(msgpack.unpackInto(msgpack.pack({'toString' : 1}), t2), t2);
+assert.deepEqual(t2, {'toString' : 1});
+assert.ok(!('x' in t2));
+
+// A key repeated in the message is counted once: {'a' : 1, 'a' : 2}
+var dup = new buffer.Buffer([0x82, 0xa1, 0x61, 0x01, 0xa1, 0x61, 0x02]);
+var t3 = {'a' : 0, 'b' : 0};
+assert.strictEqual(msgpack.unpackInto(dup, t3), t3);
+assert.deepEqual(t3, {'a' : 2});
+
+// A different shape at the top yields a new value
+assert.deepEqual(msgpack.unpackInto(msgpack.pack([1, 2]), t), [1, 2]);
+assert.equal(msgpack.unpackInto(msgpack.pack('abc'), t), 'abc');
+assert.deepEqual(msgpack.unpackInto(msgpack.pack({'x' : 1}), []), {'x' : 1});
+
+// Options and bytes_remaining work as with unpack()
+assert.throws(function() {
+    msgpack.unpackInto(msgpack.pack([1, 2, 3]), [], {maxArrayLength : 2});
+});
+var buf = msgpack.pack([1, 2], 'x');
+assert.deepEqual(msgpack.unpackInto(buf, [0, 0, 0]), [1, 2]);
+assert.equal(msgpack.unpack.bytes_remaining, 2);
@@ -0,0 +1,55 @@
+// Verify that messages exceeding the limits passed to unpack() are
+// rejected, and that messages within them are not.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+var buffer = require('buffer');
+var net = require('net');
+var netBindings = process.binding('net');
+
+var o = {'abc' : [1, 2, [3, 4]], 'defgh' : 'xyz'};
+var b = msgpack.pack(o);
+
+assert.deepEqual(msgpack.unpack(b, {}), o);
+assert.deepEqual(
+    msgpack.unpack(b, {maxDepth : 3, maxArrayLength : 3, maxMapSize : 2,
+                       maxRawLength : 5}),
+    o
+);
+
+assert.throws(function() { msgpack.unpack(b, {maxDepth : 2}); });
+assert.throws(function() { msgpack.unpack(b, {maxArrayLength : 2}); });
+assert.throws(function() { msgpack.unpack(b, {maxMapSize : 1}); });
+assert.throws(function() { msgpack.unpack(b, {maxRawLength : 4}); });
+assert.throws(function() { msgpack.unpack(b, {maxBytes : 16}); });
+assert.throws(function() { msgpack.unpack([b.slice(0, 5), b.slice(5)], {maxDepth : 2}); });
+
+// A header claiming 4G elements is rejected before the rest arrives
+var huge = new buffer.Buffer([0xdd, 0xff, 0xff, 0xff, 0xff, 0x01]);
+assert.equal(msgpack.unpack(huge), undefined);
+assert.throws(function() { msgpack.unpack(huge, {maxArrayLength : 1000}); });
+
+// A Stream reports a message exceeding its limits as an 'error' rather than
+// throwing from its 'data' listener, and goes on with the data after it
+var fds = netBindings.socketpair();
+var is = new net.Stream(fds[0]);
+var os = new net.Stream(fds[1]);
+var ms = new msgpack.Stream(is, {maxArrayLength : 2});
+var errors = 0;
+var received = [];
+ms.addListener('error', function(e) {
+    errors++;
+    os.write(msgpack.pack([1, 2]));
+});
+ms.addListener('msg', function(m) {
+    received.push(m);
+    is.end();
+    os.end();
+});
+is.resume();
+os.write(msgpack.pack([1, 2, 3]));
+
+process.addListener('exit', function() {
+    assert.equal(errors, 1);
+    assert.deepEqual(received, [[1, 2]]);
+});
@@ -0,0 +1,27 @@
+// Verify that unpacking an Array of Buffers matches unpacking their
+// concatenation, wherever the message is split.
+
+var assert = require('assert');
+var msgpack = require('msgpack');
+var buffer = require('buffer');
+
+// Object to test with; the strings are long enough to straddle a split
+var o = {'abc' : [1, 2, 3], 'long' : new Array(300).join('x'), 'n' : -70000};
+
+// Packed twice, with 3 extra bytes at the end
+var b = msgpack.pack(o);
+var bb = new buffer.Buffer(b.length * 2 + 3);
+b.copy(bb, 0, 0, b.length);
+b.copy(bb, b.length, 0, b.length);
+
+for (var i = 0; i <= bb.length; i++) {
+    // Split the buffer in three at i and i + 7
+    var j = Math.min(i + 7, bb.length);
+    var rope = [bb.slice(0, i), bb.slice(i, j), bb.slice(j, bb.length)];
+
+    assert.deepEqual(msgpack.unpack(rope), o);
+    assert.equal(msgpack.unpack.bytes_remaining, b.length + 3);
+}
+
+// An incomplete message yields undefined
+assert.equal(msgpack.unpack([b.slice(0, 10), b.slice(10, 20)]), undefined);